@@ -0,0 +1,650 @@
+// Generated by tools/gen_base_wnaf.c. Do not edit; run make base_wnaf.
+#if BASE_WNAF_BITS != 7
+#error "base_wnaf.c doesn't match BASE_WNAF_BITS. Run make base_wnaf."
+#endif
+
+// Odd multiples B, 3B, ... of the base point, for wNAF multiplication.
+__attribute__((__aligned__(32)))
+const extended_affine_pt_readd_narrow_t
+base_odd_multiples[BASE_WNAF_TABLE_SIZE] = {
+  {
+    .x = {
+      .limbs = {
+        0, 0x2862b8b, 0xf08ed2, 0x6e65ee, 0xc05991, 0x2b12b17,
+        0x49432, 0x33a3707, 0x16e5186, 0x2947e71, 0xed9bab, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x23a1bec, 0x1148cb6, 0x3711133, 0x152ea87, 0x24b95ee,
+        0x1fa1b5, 0x3dffabf, 0x98eb51, 0x3c35c0b, 0x213a50a, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x4, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x253bff6, 0x328962e, 0x223a58b, 0x1d0ab7b, 0x360800,
+        0x1f68341, 0x199d23, 0x3e23edb, 0xeedc66, 0x367b5be, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x30b1e7f, 0x3daeeec, 0x2a11aa9, 0x27727be, 0x35bd61e,
+        0x3c96e61, 0x1f289ca, 0x3d225e3, 0x12f92ec, 0x10295e0, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0xec1a30, 0x3a694ce, 0x2f46145, 0x2dd4612, 0x2b446f8,
+        0x5bdec7, 0x343045b, 0x11f917, 0x229e241, 0xd4f094, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0xbdfd1d, 0x201b139, 0x1b13d08, 0xf7af35, 0x1906584,
+        0xac60ac, 0x20fba4e, 0x3ab07ae, 0x3042d70, 0x12d44b6, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0xc346d2, 0x1df57e2, 0x30e673e, 0x2dca31d, 0x1a6fed2,
+        0x7cba2e, 0x3f43e86, 0x1df4cfe, 0x2fcf17a, 0x12ed90c, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x3cfe5d0, 0x1bb2ed1, 0x3d56eec, 0x2670b2e, 0x4f477d,
+        0x17c797e, 0x10dd260, 0x1277958, 0xe90fd0, 0x2f7fc20, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x30edd0d, 0x13e7176, 0xfb8aee, 0x2fe880, 0x2332bda,
+        0x16b396a, 0x597961, 0x385b2ae, 0x2f8f96b, 0x22083f8, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x17650f3, 0xa361e5, 0x2ed17c3, 0x3517c5a, 0x261bd3c,
+        0x26585de, 0x30cb338, 0x213c1f8, 0x3ca0864, 0x27ffb4c, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x2d77019, 0x1b4d27e, 0x13c459a, 0xf80be4, 0x32a8f69,
+        0x1036be8, 0x282f9bf, 0x11400d4, 0x3e8b105, 0xf080a9, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x235b621, 0x7bf965, 0x1054a09, 0x3c8f902, 0x2b694ca,
+        0x2331a9f, 0x2487bce, 0x3834063, 0x83370d, 0x1cde5a6, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x3bcce51, 0x98b2, 0x3d443c2, 0x1c577a7, 0x4ae740,
+        0x11699b5, 0xc9eef3, 0x14f433b, 0x197b64f, 0x2d7555d, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x2ff79f0, 0x2240edd, 0x7ed7a2, 0x37c54d9, 0xba0e65,
+        0x2e2de33, 0x3361b11, 0x1a543db, 0x2f09476, 0x233eb9d, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x2254fe7, 0x39f2553, 0x265273e, 0x11d2c9, 0x27fc7e7,
+        0x35e238, 0x7832cb, 0x29ee9b, 0xe29101, 0xed6c27, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0xb92b58, 0x16aa70, 0x30c1804, 0x7e09bb, 0x202ff92,
+        0x38fb48, 0x370e92c, 0x3e157e9, 0x132db4c, 0x2c2d050, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x23aac02, 0x35f401e, 0x94f544, 0x2d42faf, 0x24d4530,
+        0x1398bd3, 0x718124, 0x1cc764a, 0x1eccf86, 0xa963a, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x1d83b23, 0x2800763, 0x174de0a, 0x28a5eb0, 0x36ee7a3,
+        0x29db865, 0x1254321, 0x384480e, 0x3c1b046, 0x2f2f172, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x207f88e, 0x3e4f8e9, 0x362c773, 0x8b47b0, 0x2614fb6,
+        0x2818d03, 0x1504f1a, 0xe7eb91, 0x328ee61, 0x1c03826, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x318a900, 0xfb42ed, 0x21c7048, 0xef87f1, 0x1e31a4c,
+        0x2af85d5, 0x3c976ce, 0x319173d, 0x2ae8811, 0x37cf042, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x24b18db, 0x1ee1e6, 0x9f9ff3, 0x1f03606, 0xa717ba,
+        0x19b9b89, 0x1a9d026, 0x12e4b7e, 0x2b819f9, 0x2e8de05, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x591fa3, 0x2cce535, 0x1001272, 0x30fc840, 0x15832de,
+        0x2c295a1, 0x39b9f41, 0x738c0b, 0x2a23b6e, 0x234fc4a, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x2751c67, 0x9d5d20, 0x1be07f5, 0x2c7b5d7, 0x28af63c,
+        0x1c2c500, 0x174fe3e, 0x1520e5e, 0xa24e2e, 0x346b50e, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x2bff94, 0x16eac3d, 0x2eda042, 0x13d4887, 0x1b03a48,
+        0x101c253, 0xabc8b6, 0x4d316, 0x96e61c, 0x1e7fa5a, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x25c056b, 0x187865e, 0x346e00b, 0x1ac9531, 0xd6b75e,
+        0xf3dfac, 0x237b2ec, 0x13433dc, 0x393ddbc, 0x3003fe6, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x1e49e89, 0x3e581d1, 0x485732, 0x104445e, 0x91c3b0,
+        0xd02bca, 0x506405, 0x1d573f3, 0xb78198, 0x29f3492, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x34cb16, 0x10ea45d, 0xaa7a91, 0x1e26fcc, 0x33308a9,
+        0x2d9e61e, 0x3197bca, 0x12518e1, 0x1594803, 0x14a9340, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x2882be3, 0xc32dfe, 0x6a733d, 0x36a76e9, 0x3766ce9,
+        0x5cb17c, 0x27d5b77, 0x3c9fa8d, 0x30a0063, 0x727141, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0xb1d1d4, 0x214eb0e, 0xc85d70, 0x35d9d7, 0x297b75a,
+        0x1a61803, 0x14a0513, 0x2a43cce, 0x909467, 0x2616529, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3997dd1, 0x1febc00, 0xf291ad, 0x3e9a178, 0x2519eaa,
+        0x7be40f, 0x3482d1f, 0x3de32ea, 0x1d6e261, 0x333166, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x802601, 0x2ff0192, 0x23a44cf, 0x3309953, 0x3d72779,
+        0x368a91f, 0x2a64f81, 0x4ec156, 0x38c6fbf, 0x3890656, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0xc81551, 0x2ba522c, 0x3420db3, 0x394f803, 0x881bc9,
+        0x3cea8ef, 0x8a459f, 0x1b9ca9a, 0x147e9d2, 0x332a88c, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x1bd174a, 0x729380, 0x285a0e4, 0x24589d5, 0x2a4fcbe,
+        0x30f7bab, 0x2fbc605, 0x146e7d8, 0x37d4da1, 0x19cf68c, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x3143418, 0x292a0b1, 0x17bd54e, 0x393af7d, 0x2ca25b5,
+        0x1d77f3c, 0xf0ffc9, 0x3bd800b, 0x3f2f713, 0x1a3af4, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x1c099e8, 0x38e2dbe, 0x24f0940, 0x19a1e5d, 0x25a4dd8,
+        0x29a669a, 0x231189e, 0x1000b14, 0x35de6d5, 0x34aefb0, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x33c69fb, 0x2f1910c, 0x3e37359, 0x28c7a22, 0x28fa6a4,
+        0x24cf9dd, 0x3a1c657, 0x76978e, 0x198db24, 0x18a1b58, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x1b7cc08, 0x1832771, 0x1edfa76, 0x102414d, 0x1a2715f,
+        0x2e5797b, 0x12f8120, 0x3bfe744, 0x1915bc1, 0xe3a1e3, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x1974031, 0x1e0ebba, 0x4f526, 0x24ffb05, 0xfc8ad9,
+        0x1dbc96f, 0x3473440, 0x3438530, 0x12fd8ce, 0xf75f1a, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x1f88ac7, 0x3ff8982, 0x1b7676a, 0xe8215b, 0x3ed7046,
+        0x2f6223f, 0x2d07890, 0x157883a, 0x2ee0463, 0x1926612, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x3abdee4, 0x26d706d, 0x2043e2, 0x358ce65, 0x258152d,
+        0x802ade, 0x4e7c0d, 0x2df4412, 0x2b1d3cc, 0x1672ed8, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x39fddb, 0x165266c, 0x8afe00, 0x348dfbd, 0x1aa40e3,
+        0x1dcae60, 0x1d8fdd0, 0x353f771, 0x35d9ac2, 0x23a4942, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x28112eb, 0x29979e7, 0x757aa0, 0x241c096, 0xcf7960,
+        0xc25c88, 0x19fef68, 0x1bdab9c, 0x364ee3, 0x2d68b00, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x17728a6, 0x2c9cc68, 0x86cf47, 0x19c377, 0x3a51ff7,
+        0x3c752b3, 0x3bac49d, 0x826a7f, 0x3b11701, 0x2f5a792, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x1430ff5, 0x2f27b3d, 0x1bc74cb, 0x88ff99, 0x3c7e3bb,
+        0x819e3c, 0x1a895e9, 0x293ea2f, 0x1d8fcf7, 0x26ced, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x2c7762, 0x370ff29, 0xba03c3, 0x2979504, 0xdf5d22,
+        0x24a58a6, 0x3509ef9, 0xdf0d3d, 0x2074f, 0x1fa2481, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x118ce6b, 0x2bfa705, 0x3a7101d, 0x41ca42, 0x50b593,
+        0x1e2ef9f, 0x33ec7ae, 0x39a29bc, 0x115e46b, 0x1c95c6a, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x951344, 0x1a8fa9a, 0x13f731a, 0xe16a14, 0x1c11464,
+        0x8fdd88, 0x1add60c, 0x2b553a9, 0x33ed058, 0x10e233f, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3f12a97, 0x56b16b, 0x29c5c8c, 0x2d46311, 0x16ecdc6,
+        0x2a2724f, 0x31d8297, 0x2f5b3c1, 0x2726a22, 0x18b0fb0, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x30a24dd, 0x324b02, 0x230da18, 0x3b6bd66, 0x291e21e,
+        0x2b41cb, 0x2d89df7, 0x39ade87, 0x381212c, 0xaad0f7, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x2c1a8a8, 0x3efb55e, 0x33243e6, 0x2c1ff15, 0x25cadd6,
+        0x188a5f, 0x3fcb33, 0x3034104, 0x2387b82, 0x3ec7e1e, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x2aa0fdf, 0x8bf60c, 0x1a06d86, 0x2ec824f, 0x2f0953d,
+        0x345b5f7, 0x1bde3fe, 0x3d3e9d8, 0x18a3ea6, 0xce927, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x1feb051, 0x57970b, 0x2827169, 0x9cd8cc, 0x1641d55,
+        0x134a07e, 0x2196ab6, 0x1515ebc, 0xaecc7b, 0x125207e, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x28d7e37, 0x210a1b0, 0x3b7090a, 0x3e7ac21, 0x161ceb3,
+        0x16b8d75, 0x3fad746, 0x1d397b5, 0x3269120, 0x48e431, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3d3c775, 0x1da43e5, 0x3788bbc, 0xea0f82, 0x29e7d0e,
+        0x3e60696, 0x384e9d2, 0x3ba20bc, 0x396176c, 0x2b3cbd, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x83e593, 0x182ad3b, 0x279aa4b, 0xd70482, 0x2c1ca9f,
+        0x2dd5eed, 0x355f449, 0x207333a, 0x3205ca5, 0x3f0f297, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x26d440f, 0xacdee9, 0x3e60176, 0xc12fa3, 0x30d506d,
+        0x31f7306, 0x3c70628, 0x30f232, 0x3ad8f70, 0x2511b9e, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x1973d3, 0x34189a4, 0x258b17e, 0x3956a88, 0x2dda3d4,
+        0x3030410, 0x2c8cccc, 0xc3759, 0x1f60e9b, 0x112a6a1, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0xce083b, 0x2382f30, 0x3a94511, 0x107a69e, 0x979fd4,
+        0x2e22810, 0x165e5bd, 0x3a4dbf8, 0x1a1335a, 0x1d47587, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x37143ab, 0x3fe5701, 0x2394e86, 0xea62f9, 0x2115fb5,
+        0x3aa8947, 0x33bf313, 0x608e35, 0x3f0292b, 0x8797d, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x30f6ed4, 0x13a1716, 0x4ae5c1, 0x35df21a, 0xddcb2a,
+        0x2c9289f, 0x34a5041, 0xff8674, 0x1ca44ac, 0x25ae3a8, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x2b90657, 0x3b73e5d, 0x36b282e, 0x2b628c9, 0x13bfd11,
+        0xd4de0, 0xf5c908, 0x3856fe, 0x2774347, 0x1fcb5fb, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0xcb121b, 0x1194395, 0x3ba1226, 0x14a4689, 0xa3623a,
+        0x29b19fc, 0x181231f, 0x2615ee0, 0x26a4c64, 0x1d49d7b, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x15488f0, 0x359d109, 0x37d5bdb, 0x38c7706, 0x32e570f,
+        0x2db1fdf, 0x3162c8e, 0x2834dc9, 0x393ea7e, 0x1c8ba33, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x237528c, 0x21778d0, 0x134e43, 0x1bdf48c, 0x2a4cfd,
+        0x253901c, 0x3601a3c, 0x18bbd71, 0x25a3d5f, 0x28ce1f8, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x265105, 0x2440347, 0x1ec4d0a, 0x36f51bd, 0x2921515,
+        0x57a06f, 0x2083c68, 0x14d579d, 0x1aee50f, 0xed0d4e, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3c9462, 0x3f7f22e, 0x2c4460f, 0x31c22d9, 0x386889e,
+        0x360b273, 0x1fd9d15, 0x1351ff7, 0x16fb5cc, 0x2fb6d87, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x1a4c8e9, 0x2e57d0a, 0x38e245d, 0x1fed137, 0x317c0d9,
+        0x10f1c7, 0xf0a096, 0x381830d, 0x3af18aa, 0x14d3c, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x2add119, 0x4ecee3, 0x375e4dc, 0x108f662, 0x2c034bd,
+        0x13e2660, 0x3ecea83, 0x13b5b6a, 0x135ad87, 0x1f3bdb7, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3b4502e, 0x3dc2887, 0x16dd7af, 0x941590, 0x3ea8c7b,
+        0x105c3a6, 0x22d16c6, 0xd90100, 0x524e2b, 0x3e203fe, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x8aa011, 0x29be2e2, 0x3485894, 0x25150e8, 0x3876268,
+        0x1875557, 0x157b958, 0x4c441c, 0x3f3b878, 0x7358fe, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0xc0676f, 0x3db5812, 0x7cb6a7, 0x3f92f15, 0x1b9055d,
+        0x243488f, 0x3653077, 0x3ff5c2e, 0x3a0c329, 0x2aa4dad, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x3c73d0f, 0x29eb13e, 0xa9dbdc, 0x25765d9, 0x59d36e,
+        0x166ca99, 0x2535ecf, 0x3c7a3a4, 0x30f7f37, 0x27fa940, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x1272f30, 0x29d3fbd, 0x31b7ae8, 0x35cead1, 0x3e2831c,
+        0x3874dfc, 0xc01045, 0x2daa10d, 0x3de7745, 0x3ec7fd6, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x31bd1de, 0x36b7b16, 0xa6f957, 0x3326971, 0x35e0e9f,
+        0x2f36360, 0x1d4dd7e, 0x213334c, 0x2cbee46, 0x2339809, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x751108, 0x370ac6e, 0x7b1516, 0x7c27b0, 0xd8ca62,
+        0x3aff406, 0x25265af, 0x3a1662d, 0x3ed3ead, 0x12db3f8, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x2f6bc6b, 0x2db633e, 0x32481a0, 0x1f53eb2, 0x3f0ec29,
+        0x2570e11, 0x2097963, 0x2056d03, 0x293bfc8, 0x2b4f3c, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x3921abb, 0x3064461, 0x12f4422, 0x34a30e7, 0x2a4ecc4,
+        0x378a3ac, 0x3aef84e, 0x1af2f70, 0x350d949, 0x3f874ee, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x32cd5cd, 0x136a224, 0x1268d15, 0x455e2a, 0x221972b,
+        0x392d734, 0x4b110c, 0x372af63, 0x3b7acc9, 0xa25fd3, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x310fa36, 0x1b0846c, 0x2879c1c, 0xb3fd56, 0x3f1b5bd,
+        0x286e671, 0x93bc12, 0x45fb96, 0x38f1e4b, 0x1b8842c, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x39ab5ee, 0x11fa0b9, 0x30ff2db, 0x38198a8, 0x22d2bb5,
+        0x107e013, 0x31c79d2, 0x3ca2f5a, 0x2ef5a99, 0x3118993, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0xa398a2, 0x2a3a5cb, 0xe5fbff, 0x1700bdb, 0x2bb0b54,
+        0x81701a, 0x265e293, 0x1af383, 0xe2f089, 0xb30a37, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x162900c, 0x1c8968c, 0x78b4de, 0x1205923, 0x2541ab4,
+        0x10e5d1, 0x1e90e42, 0x1f13b04, 0x2f9d064, 0x1f30f6b, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x3148cc7, 0x2a43354, 0x3d1acbd, 0x1fb0303, 0x2215fd3,
+        0x987c3e, 0x1cc2dad, 0x373b12a, 0xced513, 0x31a1520, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x333c05b, 0xb21ff7, 0x38b396, 0x2f824a2, 0x3c65db8,
+        0x2c697f2, 0x2c7b69e, 0x132f8d5, 0x1c5db85, 0x1571421, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x31101eb, 0x20c91ca, 0x1ba109f, 0x4b017b, 0x3d4f9e2,
+        0x2d3c83c, 0x33e74cc, 0x2ef0430, 0x2249529, 0x3b70323, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x3ab6ad, 0xdc80eb, 0xda5494, 0x143cf12, 0x32981c5,
+        0x7a8dc7, 0xc8a79b, 0xe62f40, 0x2cfd2af, 0x3a2b35b, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x2b65600, 0x9d5e9, 0x10dfd25, 0x4307d2, 0x119e035,
+        0x877c8e, 0x25bc6ce, 0x32bb787, 0x2f8890c, 0x3cd5224, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x3449904, 0x3ede185, 0x261c45b, 0x1ccf60a, 0x36de5d5,
+        0x395d9a8, 0x1f27a02, 0x1a666c8, 0x3a0b327, 0x157d782, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x24e2ecf, 0x286d106, 0x5fbb44, 0x3587563, 0x51b6b,
+        0x2b2ddc6, 0x21413fd, 0x39ebd32, 0x3e3f1a1, 0x2311c9b, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0xcbf3df, 0x2a107bd, 0xb9880f, 0x18171c2, 0x3de2344,
+        0x2fb3d6d, 0x1eeb100, 0x2864784, 0x1e731b5, 0x80548f, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x2597c2a, 0xba255f, 0x8b9683, 0x130a30c, 0x2334f95,
+        0x398a666, 0x3b31a38, 0x158cfde, 0x3d4f99c, 0x3e253a7, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x929968, 0x189efa4, 0x2e1036e, 0x94a035, 0x2250dbb,
+        0x174ef15, 0xb85193, 0xfcef5a, 0x88c651, 0x36266d0, 0,
+      },
+    },
+  },
+  {
+    .x = {
+      .limbs = {
+        0, 0x4a7fc6, 0x70d40d, 0x3f39ea3, 0x1045b09, 0x18cd213,
+        0x961ee8, 0x375ab84, 0x3380f1f, 0x3388dc, 0x3d6ac8b, 0,
+      },
+    },
+    .dt = {
+      .limbs = {
+        0, 0x35fd33a, 0xf35ca6, 0x2b3790a, 0xfd2d8e, 0x1255fae,
+        0x139b484, 0x35487fa, 0x34c8f17, 0x16df34c, 0x5a114e, 0,
+      },
+    },
+    .y = {
+      .limbs = {
+        0, 0x92abf7, 0x11af269, 0x3d0b40b, 0x1deea92, 0x31ab375,
+        0x1c0d0be, 0x2dd4043, 0x4d0267, 0x2db9fa5, 0xad85fd, 0,
+      },
+    },
+  },
+};
@@ -4,11 +4,21 @@
 #include "curve.h"
 #include "scalar.h"
 
-#define COMB_TABLE_SIZE 16
+// The comb geometry can be set at build time. Each comb has COMB_TEETH teeth,
+// and there are COMB_COUNT combs. More teeth or combs mean a larger table, but
+// fewer doublings per multiplication. include/base_comb.c has to be
+// regenerated to match; see the base_comb target in the Makefile.
+#ifndef COMB_TEETH
 #define COMB_TEETH 5
+#endif
+#ifndef COMB_COUNT
 #define COMB_COUNT 4
-#define COMB_SEPARATION 13
-#define COMB_LOOKUP_MASK 0xf
+#endif
+// Enough separation that the teeth cover every bit of a scalar.
+#define COMB_SEPARATION \
+  ((SCALAR_BITS + COMB_TEETH * COMB_COUNT - 1) / (COMB_TEETH * COMB_COUNT))
+#define COMB_TABLE_SIZE (1 << (COMB_TEETH - 1))
+#define COMB_LOOKUP_MASK (COMB_TABLE_SIZE - 1)
 
 // A single comb table.
 typedef struct sabs_single_comb {
@@ -43,10 +53,18 @@ typedef struct teeth_set {
 // The base comb used for fast signatures.
 sabs_comb_set_t base_comb;
 
+// (2^(COMB_TEETH * COMB_COUNT * COMB_SEPARATION) - 1) mod l. Used to convert
+// scalars to SABS representation for comb multiplication. Generated along with
+// base_comb, because it depends on the comb geometry.
+const scalar_t comb_signed_bits_set_adjustment;
+
 // Compute a comb set for a given point.
 void compute_comb_set(
   sabs_comb_set_t *result, const affine_pt_narrow_t *base_pt);
 
+// Convert a scalar to SABS representation for comb multiplication.
+void convert_to_comb_sabs(scalar_t *result, const scalar_t * __restrict x);
+
 // Helper function used to compute a comb set.
 void reduce_comb_set(sabs_comb_set_t *result, sabs_comb_set_wide_t *source);
 
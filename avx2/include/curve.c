@@ -1,3 +1,4 @@
+#include <stdlib.h>
 #include <string.h>
 #include "f11_260.h"
 #include "scalar.h"
@@ -19,6 +20,10 @@ const affine_pt_narrow_t B = {
   },
 };
 
+#ifndef BASE_WNAF_NO_TABLE
+#include "base_wnaf.c"
+#endif
+
 void copy_projective_pt_wide(
   projective_pt_wide_t *result, const projective_pt_wide_t *source) {
 
@@ -162,6 +167,20 @@ void affine_to_readd_wide(
   mul_wide_const(&result->dt, &xy, D);
 }
 
+void affine_to_affine_readd_narrow(
+  extended_affine_pt_readd_narrow_t *result,
+  const affine_pt_narrow_t * __restrict x) {
+
+  copy_narrow(&result->x, &x->x);
+  copy_narrow(&result->y, &x->y);
+
+  residue_wide_t xy;
+  residue_wide_t dt_wide;
+  mul_narrow(&xy, &x->x, &x->y);
+  mul_wide_const(&dt_wide, &xy, D);
+  narrow(&result->dt, &dt_wide);
+}
+
 void extended_to_readd_wide_neg(
   extended_pt_readd_wide_t *result,
   const extended_pt_wide_t * __restrict x) {
@@ -624,59 +643,51 @@ void scalar_multiply_unsafe(
   projective_pt_wide_t *result, const affine_pt_narrow_t * __restrict x,
   const scalar_t * __restrict n) {
 
-  scalar_t sabs_n;
-  convert_to_sabs(&sabs_n, n);
-
-  const int WINDOW_BITS = 5;
-  const uint32_t WINDOW_MASK = (1 << WINDOW_BITS) - 1;
-  const uint32_t LOOKUP_MASK = WINDOW_MASK >> 1;
-  const int TABLE_SIZE = 16;
-  extended_pt_readd_narrow_t table[TABLE_SIZE];
+  extended_pt_readd_narrow_t table[VAR_WNAF_TABLE_SIZE];
 
   extended_pt_wide_t x2;
   affine_double_extended(&x2, x);
   affine_to_readd_narrow(&table[0], x);
-  for (int i = 1; i < TABLE_SIZE; ++i) {
+  for (int i = 1; i < VAR_WNAF_TABLE_SIZE; ++i) {
     extended_readd_readd_narrow(&table[i], &x2, &table[i-1]);
   }
 
-  int i;
-  int first = 1;
-  // Set i to the highest i such that
-  // a) i < SCALAR_BITS
-  // b) i % WINDOW_BITS = 0
+  int8_t n_wnaf[SCALAR_WNAF_LENGTH];
+  int n_len = convert_to_wnaf(n_wnaf, n, VAR_WNAF_BITS);
+
+  if (n_len == 0) {
+    copy_wide(&result->x, &zero_wide);
+    copy_wide(&result->y, &one_wide);
+    copy_wide(&result->z, &one_wide);
+    return;
+  }
 
   projective_pt_wide_t temp;
   extended_pt_wide_t temp_ext;
   extended_pt_readd_narrow_t window_pt;
 
-  i = SCALAR_BITS - ((SCALAR_BITS - 1) % WINDOW_BITS) - 1;
-  for (; i >= 0; i -= WINDOW_BITS) {
-    uint32_t bits = sabs_n.limbs[i/SCALAR_LIMB_BITS] >> (i % SCALAR_LIMB_BITS);
-    if (i % SCALAR_LIMB_BITS > (SCALAR_LIMB_BITS - WINDOW_BITS) &&
-        i / SCALAR_LIMB_BITS < SCALAR_LIMBS - 1) {
+  // The top digit is always non-zero.
+  for (int i = n_len - 1; i >= 0; --i) {
+    int digit = n_wnaf[i];
 
-      bits |= sabs_n.limbs[i/SCALAR_LIMB_BITS + 1] <<
-        (SCALAR_LIMB_BITS - i % SCALAR_LIMB_BITS);
+    if (i != n_len - 1) {
+      // Only use an extended doubling when its output is needed.
+      if (digit == 0) {
+        projective_double(&temp, &temp);
+        continue;
+      }
+      projective_double_extended(&temp_ext, &temp);
     }
 
-    bits &= WINDOW_MASK;
-    int32_t invert = (bits >> (WINDOW_BITS - 1)) - 1;
-    bits ^= invert;
-
-    copy_extended_pt_readd_narrow(&window_pt, &table[bits & LOOKUP_MASK]);
-    if (invert) {
+    copy_extended_pt_readd_narrow(
+      &window_pt, &table[(digit < 0 ? -digit : digit) >> 1]);
+    if (digit < 0) {
       negate_extended_pt_readd_narrow(&window_pt, &window_pt);
     }
 
-    if (first) {
+    if (i == n_len - 1) {
       readd_to_projective(&temp, &window_pt);
-      first = 0;
     } else {
-      for (int i = 0; i < WINDOW_BITS - 1; ++i) {
-        projective_double(&temp, &temp);
-      }
-      projective_double_extended(&temp_ext, &temp);
       extended_readd_narrow(&temp, &temp_ext, &window_pt);
     }
   }
@@ -684,6 +695,270 @@ void scalar_multiply_unsafe(
   copy_projective_pt_wide(result, &temp);
 }
 
+void compute_odd_multiples(
+  extended_affine_pt_readd_narrow_t result[BASE_WNAF_TABLE_SIZE],
+  const affine_pt_narrow_t * __restrict x) {
+
+  extended_pt_readd_narrow_t table[BASE_WNAF_TABLE_SIZE];
+  residue_narrow_t z[BASE_WNAF_TABLE_SIZE];
+  residue_narrow_t z_inv[BASE_WNAF_TABLE_SIZE];
+
+  extended_pt_wide_t x2;
+  affine_double_extended(&x2, x);
+  affine_to_readd_narrow(&table[0], x);
+  for (int i = 1; i < BASE_WNAF_TABLE_SIZE; ++i) {
+    extended_readd_readd_narrow(&table[i], &x2, &table[i-1]);
+  }
+
+  for (int i = 0; i < BASE_WNAF_TABLE_SIZE; ++i) {
+    copy_narrow(&z[i], &table[i].z);
+  }
+  invert_narrow_batch(z_inv, z, BASE_WNAF_TABLE_SIZE);
+
+  for (int i = 0; i < BASE_WNAF_TABLE_SIZE; ++i) {
+    residue_wide_t temp;
+
+    mul_narrow(&temp, &table[i].x, &z_inv[i]);
+    narrow(&result[i].x, &temp);
+    mul_narrow(&temp, &table[i].y, &z_inv[i]);
+    narrow(&result[i].y, &temp);
+    mul_narrow(&temp, &result[i].x, &result[i].y);
+    mul_wide_const(&temp, &temp, D);
+    narrow(&result[i].dt, &temp);
+  }
+}
+
+void double_scalar_multiply_unsafe(
+  projective_pt_wide_t *result, const scalar_t * __restrict s,
+  const affine_pt_narrow_t * __restrict x, const scalar_t * __restrict h) {
+
+  extended_pt_readd_narrow_t table[VAR_WNAF_TABLE_SIZE];
+
+  extended_pt_wide_t x2;
+  affine_double_extended(&x2, x);
+  affine_to_readd_narrow(&table[0], x);
+  for (int i = 1; i < VAR_WNAF_TABLE_SIZE; ++i) {
+    extended_readd_readd_narrow(&table[i], &x2, &table[i-1]);
+  }
+
+  int8_t s_wnaf[SCALAR_WNAF_LENGTH];
+  int8_t h_wnaf[SCALAR_WNAF_LENGTH];
+  int s_len = convert_to_wnaf(s_wnaf, s, BASE_WNAF_BITS);
+  int h_len = convert_to_wnaf(h_wnaf, h, VAR_WNAF_BITS);
+
+  projective_pt_wide_t temp;
+  extended_pt_wide_t temp_ext[2];
+  extended_pt_readd_narrow_t window_pt;
+  extended_affine_pt_readd_narrow_t base_pt;
+  int started = 0;
+  int cur = 0;
+
+  for (int i = (s_len > h_len ? s_len : h_len) - 1; i >= 0; --i) {
+    int s_digit = s_wnaf[i];
+    int h_digit = h_wnaf[i];
+
+    if (started) {
+      // Only use an extended doubling when its output is needed.
+      if (s_digit == 0 && h_digit == 0) {
+        projective_double(&temp, &temp);
+        continue;
+      }
+      projective_double_extended(&temp_ext[cur], &temp);
+    } else {
+      if (s_digit == 0 && h_digit == 0) {
+        continue;
+      }
+      copy_wide(&temp_ext[cur].x, &zero_wide);
+      copy_wide(&temp_ext[cur].y, &one_wide);
+      copy_wide(&temp_ext[cur].t, &zero_wide);
+      copy_wide(&temp_ext[cur].z, &one_wide);
+      started = 1;
+    }
+
+    if (h_digit != 0) {
+      copy_extended_pt_readd_narrow(
+        &window_pt, &table[(h_digit < 0 ? -h_digit : h_digit) >> 1]);
+      if (h_digit < 0) {
+        negate_extended_pt_readd_narrow(&window_pt, &window_pt);
+      }
+      extended_readd_narrow_extended(
+        &temp_ext[cur ^ 1], &temp_ext[cur], &window_pt);
+      cur ^= 1;
+    }
+
+    if (s_digit != 0) {
+      copy_extended_affine_pt_readd_narrow(
+        &base_pt, &base_odd_multiples[(s_digit < 0 ? -s_digit : s_digit) >> 1]);
+      if (s_digit < 0) {
+        negate_extended_affine_pt_readd_narrow(&base_pt, &base_pt);
+      }
+      extended_readd_affine_narrow_extended(
+        &temp_ext[cur ^ 1], &temp_ext[cur], &base_pt);
+      cur ^= 1;
+    }
+
+    extended_to_projective_wide(&temp, &temp_ext[cur]);
+  }
+
+  if (started) {
+    copy_projective_pt_wide(result, &temp);
+  } else {
+    copy_wide(&result->x, &zero_wide);
+    copy_wide(&result->y, &one_wide);
+    copy_wide(&result->z, &one_wide);
+  }
+}
+
+// Largest bucket window used by multi_scalar_multiply_unsafe. Bounds the
+// bucket memory to 2^(MSM_MAX_WINDOW_BITS - 1) extended points.
+#define MSM_MAX_WINDOW_BITS 14
+
+// Pick the window width that minimizes the estimated number of additions for a
+// sum of n terms: each window costs n bucket additions plus about 2^c
+// additions to sum up the buckets.
+static int msm_window_bits(size_t n) {
+  int best_bits = 1;
+  size_t best_cost = SIZE_MAX;
+  for (int bits = 1; bits <= MSM_MAX_WINDOW_BITS; ++bits) {
+    size_t windows = (SCALAR_BITS + 1 + bits) / bits;
+    size_t cost = windows * (n + ((size_t) 1 << bits));
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_bits = bits;
+    }
+  }
+  return best_bits;
+}
+
+int multi_scalar_multiply_unsafe(
+  projective_pt_wide_t *result, const affine_pt_narrow_t *points,
+  const scalar_t *scalars, size_t n) {
+
+  const int WINDOW_BITS = msm_window_bits(n);
+  // Digits are signed, and a carry out of the top bit needs a window. Scalars
+  // may be as large as 2l, so WINDOWS * WINDOW_BITS > SCALAR_BITS + 1.
+  const int WINDOWS = (SCALAR_BITS + 1 + WINDOW_BITS) / WINDOW_BITS;
+  const int BUCKETS = 1 << (WINDOW_BITS - 1);
+
+  extended_affine_pt_readd_narrow_t *table = aligned_alloc(
+    _Alignof(extended_affine_pt_readd_narrow_t),
+    n * sizeof(extended_affine_pt_readd_narrow_t));
+  extended_pt_wide_t *buckets = aligned_alloc(
+    _Alignof(extended_pt_wide_t), BUCKETS * sizeof(extended_pt_wide_t));
+  int16_t *digits = malloc(n * WINDOWS * sizeof(int16_t));
+  uint8_t *bucket_used = malloc(BUCKETS);
+  if ((n > 0 && (table == NULL || digits == NULL)) ||
+      buckets == NULL || bucket_used == NULL) {
+    free(table);
+    free(buckets);
+    free(digits);
+    free(bucket_used);
+    return 0;
+  }
+
+  // Recode each scalar into signed digits in [-2^(c-1), 2^(c-1)] so that only
+  // half as many buckets are needed.
+  for (size_t j = 0; j < n; ++j) {
+    affine_to_affine_readd_narrow(&table[j], &points[j]);
+    int32_t carry = 0;
+    for (int w = 0; w < WINDOWS; ++w) {
+      int32_t digit =
+        scalar_window(&scalars[j], w * WINDOW_BITS, WINDOW_BITS) + carry;
+      carry = digit > BUCKETS;
+      digit -= carry << WINDOW_BITS;
+      digits[j * WINDOWS + w] = digit;
+    }
+  }
+
+  projective_pt_wide_t temp;
+  extended_pt_wide_t acc;
+  extended_pt_wide_t running;
+  extended_pt_wide_t window_sum;
+  extended_pt_wide_t sum_temp;
+  extended_affine_pt_readd_narrow_t window_pt;
+  int acc_empty = 1;
+
+  for (int w = WINDOWS - 1; w >= 0; --w) {
+    memset(bucket_used, 0, BUCKETS);
+    for (size_t j = 0; j < n; ++j) {
+      int32_t digit = digits[j * WINDOWS + w];
+      if (digit == 0) {
+        continue;
+      }
+      const extended_affine_pt_readd_narrow_t *pt = &table[j];
+      if (digit < 0) {
+        negate_extended_affine_pt_readd_narrow(&window_pt, pt);
+        pt = &window_pt;
+        digit = -digit;
+      }
+      extended_pt_wide_t *bucket = &buckets[digit - 1];
+      if (bucket_used[digit - 1]) {
+        extended_readd_affine_narrow_extended(&sum_temp, bucket, pt);
+        copy_extended_pt_wide(bucket, &sum_temp);
+      } else {
+        affine_readd_to_extended(bucket, pt);
+        bucket_used[digit - 1] = 1;
+      }
+    }
+
+    // window_sum = sum of (i + 1) * buckets[i], computed with a running sum
+    // from the top bucket down.
+    int running_empty = 1;
+    int window_empty = 1;
+    for (int i = BUCKETS - 1; i >= 0; --i) {
+      if (bucket_used[i]) {
+        if (running_empty) {
+          copy_extended_pt_wide(&running, &buckets[i]);
+          running_empty = 0;
+        } else {
+          extended_add_extended(&sum_temp, &running, &buckets[i]);
+          copy_extended_pt_wide(&running, &sum_temp);
+        }
+      }
+      if (!running_empty) {
+        if (window_empty) {
+          copy_extended_pt_wide(&window_sum, &running);
+          window_empty = 0;
+        } else {
+          extended_add_extended(&sum_temp, &window_sum, &running);
+          copy_extended_pt_wide(&window_sum, &sum_temp);
+        }
+      }
+    }
+
+    if (!acc_empty) {
+      extended_to_projective_wide(&temp, &acc);
+      for (int k = 0; k < WINDOW_BITS - 1; ++k) {
+        projective_double(&temp, &temp);
+      }
+      projective_double_extended(&acc, &temp);
+    }
+    if (!window_empty) {
+      if (acc_empty) {
+        copy_extended_pt_wide(&acc, &window_sum);
+        acc_empty = 0;
+      } else {
+        extended_add_extended(&sum_temp, &acc, &window_sum);
+        copy_extended_pt_wide(&acc, &sum_temp);
+      }
+    }
+  }
+
+  if (acc_empty) {
+    copy_wide(&result->x, &zero_wide);
+    copy_wide(&result->y, &one_wide);
+    copy_wide(&result->z, &one_wide);
+  } else {
+    extended_to_projective_wide(result, &acc);
+  }
+
+  free(table);
+  free(buckets);
+  free(digits);
+  free(bucket_used);
+  return 1;
+}
+
 int point_decompress(
   affine_pt_narrow_t *result,
   residue_narrow_reduced_t *y, int low_bit) {
@@ -0,0 +1,133 @@
+#include "curve.h"
+#include "curve_x4.h"
+#include "f11_260.h"
+#include "f11_260_x4.h"
+#include "immintrin.h"
+
+// Immediate for _mm256_permute4x64_epi64 that puts lane li in lane i.
+#define LANES(l0, l1, l2, l3) ((l0) | ((l1) << 2) | ((l2) << 4) | ((l3) << 6))
+// _mm256_blend_epi32 masks selecting 64-bit lanes.
+#define BLEND_LANE1_3 0xcc
+#define BLEND_LANE2_3 0xf0
+#define BLEND_LANE3 0xc0
+#define BLEND_LANE1_2_3 0xfc
+
+void extended_to_x4(extended_pt_x4_t *result, const extended_pt_wide_t *x) {
+  pack_x4_wide(&result->xyzt, &x->x, &x->y, &x->z, &x->t);
+}
+
+void x4_to_extended(extended_pt_wide_t *result, const extended_pt_x4_t *x) {
+  residue_wide_t coordinates[LANES_X4];
+  unpack_x4_wide(coordinates, &x->xyzt);
+  copy_wide(&result->x, &coordinates[0]);
+  copy_wide(&result->y, &coordinates[1]);
+  copy_wide(&result->z, &coordinates[2]);
+  copy_wide(&result->t, &coordinates[3]);
+}
+
+void x4_to_projective_wide(
+  projective_pt_wide_t *result, const extended_pt_x4_t *x) {
+  residue_wide_t coordinates[LANES_X4];
+  unpack_x4_wide(coordinates, &x->xyzt);
+  copy_wide(&result->x, &coordinates[0]);
+  copy_wide(&result->y, &coordinates[1]);
+  copy_wide(&result->z, &coordinates[2]);
+}
+
+void affine_readd_to_extended_x4(
+  extended_pt_x4_t *result,
+  const extended_affine_pt_readd_narrow_t * __restrict x) {
+  extended_pt_wide_t temp;
+  affine_readd_to_extended(&temp, x);
+  extended_to_x4(result, &temp);
+}
+
+// The second stage of both doubling and addition. Given [g, h, f, e] in each
+// limb, computes x = e * f, y = g * h, z = f * g and t = e * h.
+static inline void finish_x4(
+  extended_pt_x4_t *result, residue_x4_t *gh_fe) {
+  residue_x4_t efge, fhgh;
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i w = _mm256_load_si256((__m256i*) gh_fe->limbs[i]);
+    _mm256_store_si256((__m256i*) efge.limbs[i],
+      _mm256_permute4x64_epi64(w, LANES(3, 0, 2, 3)));
+    _mm256_store_si256((__m256i*) fhgh.limbs[i],
+      _mm256_permute4x64_epi64(w, LANES(2, 1, 0, 1)));
+  }
+  mul_x4(&result->xyzt, &efge, &fhgh);
+}
+
+void extended_double_extended_x4(
+  extended_pt_x4_t *result, const extended_pt_x4_t *x) {
+
+  residue_x4_t squares;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i double_lane2 = _mm256_set_epi64x(0, 1, 0, 0);
+
+  // [x, y, z, x + y]
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i v = _mm256_load_si256((__m256i*) x->xyzt.limbs[i]);
+    __m256i yyyy = _mm256_permute4x64_epi64(v, LANES(1, 1, 1, 1));
+    v = _mm256_permute4x64_epi64(v, LANES(0, 1, 2, 0));
+    v = _mm256_add_epi64(v, _mm256_blend_epi32(zero, yyyy, BLEND_LANE3));
+    _mm256_store_si256((__m256i*) squares.limbs[i], v);
+  }
+  // [a, b, c / 2, e + a + b]
+  square_x4(&squares, &squares);
+
+  // [g, h, f, e] = [a + b, a - b, a + b - c, e]
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i m = _mm256_load_si256((__m256i*) squares.limbs[i]);
+    __m256i aaae = _mm256_permute4x64_epi64(m, LANES(0, 0, 0, 3));
+    __m256i bbbb = _mm256_permute4x64_epi64(m, LANES(1, 1, 1, 1));
+    __m256i w = _mm256_blend_epi32(
+      _mm256_add_epi64(aaae, bbbb), _mm256_sub_epi64(aaae, bbbb),
+      BLEND_LANE1_3);
+    __m256i ca = _mm256_permute4x64_epi64(m, LANES(0, 0, 2, 0));
+    ca = _mm256_sllv_epi64(ca, double_lane2);
+    w = _mm256_sub_epi64(w, _mm256_blend_epi32(zero, ca, BLEND_LANE2_3));
+    _mm256_store_si256((__m256i*) squares.limbs[i], w);
+  }
+  finish_x4(result, &squares);
+}
+
+void extended_readd_affine_narrow_extended_x4(
+  extended_pt_x4_t *result, const extended_pt_x4_t *x1,
+  const extended_affine_pt_readd_narrow_t * __restrict x2) {
+
+  residue_x4_t lhs, rhs;
+  __m256i zero = _mm256_setzero_si256();
+
+  pack_x4(&rhs, &x2->x, &x2->y, &x2->dt, &x2->x);
+  // [x1, y1, t1, x1 + y1] and [x2, y2, dt2, x2 + y2]
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i v = _mm256_load_si256((__m256i*) x1->xyzt.limbs[i]);
+    __m256i yyyy = _mm256_permute4x64_epi64(v, LANES(1, 1, 1, 1));
+    v = _mm256_permute4x64_epi64(v, LANES(0, 1, 3, 0));
+    v = _mm256_add_epi64(v, _mm256_blend_epi32(zero, yyyy, BLEND_LANE3));
+    _mm256_store_si256((__m256i*) lhs.limbs[i], v);
+
+    __m256i q = _mm256_load_si256((__m256i*) rhs.limbs[i]);
+    yyyy = _mm256_permute4x64_epi64(q, LANES(1, 1, 1, 1));
+    q = _mm256_add_epi64(q, _mm256_blend_epi32(zero, yyyy, BLEND_LANE3));
+    _mm256_store_si256((__m256i*) rhs.limbs[i], q);
+  }
+  // [a, b, c, e + a + b]
+  mul_x4(&lhs, &lhs, &rhs);
+
+  // [g, h, f, e] = [z1 + c, b - a, z1 - c, e]
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i m = _mm256_load_si256((__m256i*) lhs.limbs[i]);
+    __m256i v = _mm256_load_si256((__m256i*) x1->xyzt.limbs[i]);
+    __m256i zbze = _mm256_blend_epi32(
+      _mm256_permute4x64_epi64(v, LANES(2, 2, 2, 2)), m, BLEND_LANE1_3);
+    __m256i caca = _mm256_permute4x64_epi64(m, LANES(2, 0, 2, 0));
+    __m256i w = _mm256_blend_epi32(
+      _mm256_add_epi64(zbze, caca), _mm256_sub_epi64(zbze, caca),
+      BLEND_LANE1_2_3);
+    __m256i bbbb = _mm256_permute4x64_epi64(m, LANES(1, 1, 1, 1));
+    w = _mm256_sub_epi64(w, _mm256_blend_epi32(zero, bbbb, BLEND_LANE3));
+    _mm256_store_si256((__m256i*) lhs.limbs[i], w);
+  }
+  finish_x4(result, &lhs);
+}
@@ -0,0 +1,35 @@
+// Extended points with the four coordinates in the four lanes of a
+// residue_x4_t. Each stage of an addition or doubling has four independent
+// multiplies, and these formulas do each stage as one mul_x4 or square_x4.
+// The linear steps between stages are done with lane permutes.
+
+#ifndef CURVE_X4_H
+#define CURVE_X4_H
+#include "curve.h"
+#include "f11_260_x4.h"
+
+// Lane j of each limb holds coordinate j: x, y, z, t.
+typedef struct extended_pt_x4 {
+  residue_x4_t xyzt;
+} extended_pt_x4_t;
+
+void extended_to_x4(extended_pt_x4_t *result, const extended_pt_wide_t *x);
+
+void x4_to_extended(extended_pt_wide_t *result, const extended_pt_x4_t *x);
+
+void x4_to_projective_wide(
+  projective_pt_wide_t *result, const extended_pt_x4_t *x);
+
+void affine_readd_to_extended_x4(
+  extended_pt_x4_t *result,
+  const extended_affine_pt_readd_narrow_t * __restrict x);
+
+// Same formulas as extended_double_extended.
+void extended_double_extended_x4(
+  extended_pt_x4_t *result, const extended_pt_x4_t *x);
+
+// Same formulas as extended_readd_affine_narrow_extended.
+void extended_readd_affine_narrow_extended_x4(
+  extended_pt_x4_t *result, const extended_pt_x4_t *x1,
+  const extended_affine_pt_readd_narrow_t * __restrict x2);
+#endif
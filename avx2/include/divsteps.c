@@ -0,0 +1 @@
+../../ref/include/divsteps.c
\ No newline at end of file
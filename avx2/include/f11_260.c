@@ -1,8 +1,13 @@
 #include <stdint.h>
 #include "f11_260.h"
+#include "carry_mask.h"
+#include "divsteps.h"
 #include "emmintrin.h"
 #include "immintrin.h"
 
+// Shared by all the backends. See divsteps.h
+#include "divsteps.c"
+
 residue_wide_t zero_wide = {0};
 residue_wide_t one_wide = {
   .limbs = {0, 1},
@@ -12,6 +17,22 @@ residue_narrow_t one_narrow = {
   .limbs = {0, 1},
 };
 
+#ifdef FIELD_BOUNDS_CHECK
+#include <assert.h>
+
+void check_bounds_narrow(const residue_narrow_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
+
+void check_bounds_wide(const residue_wide_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
+#endif
+
 #define NVECTORS 3
 #define VECTWIDTH 4
 
@@ -57,94 +78,165 @@ void narrow_reduce(
   }
 }
 
-// Reduce to unique representative.
-// This is expensive. Only used for final signature or DH Key
-void narrow_complete(
-  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+// narrow_complete works on limbs 0-7 in the lanes of low, and limbs 8-10 in
+// lanes 0-2 of high, so that bit i of a compare mask is limb i. The other lanes
+// of high start out zero, and are ignored.
+
+// The limbs in mask, as all ones lanes. mask has no bits above limb 10.
+static inline void expand_limb_mask(
+  __m256i *low, __m256i *high, uint32_t mask) {
+  __m256i bits_low = _mm256_setr_epi32(
+    1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7);
+  __m256i bits_high = _mm256_setr_epi32(
+    1 << 8, 1 << 9, 1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14, 1 << 15);
+  __m256i m = _mm256_set1_epi32(mask);
+  *low = _mm256_cmpeq_epi32(_mm256_and_si256(m, bits_low), bits_low);
+  *high = _mm256_cmpeq_epi32(_mm256_and_si256(m, bits_high), bits_high);
+}
 
-  residue_narrow_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[0];
-  }
+// The limbs whose lanes have their top bit set.
+static inline uint32_t limb_mask(__m256i low, __m256i high) {
+  return (_mm256_movemask_ps(_mm256_castsi256_ps(low)) |
+    (_mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8)) & DIGITS_MASK;
+}
 
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
+// The limbs equal to v.
+static inline uint32_t limbs_equal(__m256i low, __m256i high, int32_t v) {
+  __m256i v_vec = _mm256_set1_epi32(v);
+  return limb_mask(
+    _mm256_cmpeq_epi32(low, v_vec), _mm256_cmpeq_epi32(high, v_vec));
+}
 
-  int gt_mask = 0;
-  int lt_mask = 0;
-  int32_t limit[NLIMBS];
-  for (int i = 1; i < NLIMBS; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[0];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & gt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-  }
-  for (int i = 1; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] -= temp.limbs[11];
-    limit[i] = T;
-  }
-  int64_t all_t = -1;
-  for (int i = NLIMBS - 3; i >= 1; --i) {
-    all_t &= -(temp.limbs[i+1] == T);
-    limit[i] -= 1 & (~all_t);
-  }
-  gt_mask = 0;
-  lt_mask = 0;
-  for (int i = 1; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > limit[i]);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i-1] = temp.limbs[i];
-  }
+// Add v to the limbs in mask.
+static inline void add_limbs_masked(
+  __m256i *low, __m256i *high, uint32_t mask, int32_t v) {
+  __m256i mask_low, mask_high;
+  expand_limb_mask(&mask_low, &mask_high, mask);
+  __m256i v_vec = _mm256_set1_epi32(v);
+  *low = _mm256_add_epi32(*low, _mm256_and_si256(mask_low, v_vec));
+  *high = _mm256_add_epi32(*high, _mm256_and_si256(mask_high, v_vec));
 }
 
-// Reduce to mostly unique representative.
-// All coefficients are reduced to 0 <= xi <= t
-// Unique up to carries (xi == t) => (xi = 0; x[i+1] += 1);
-// This is sufficient to determine if x is even or odd.
-// Still pretty expensive. Used in point compression.
-void narrow_partial_complete(
-  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+// Add each lane to the limb above it, and limb 10 to limb 0.
+static inline void add_rotated(
+  __m256i *low, __m256i *high, __m256i x_low, __m256i x_high) {
+  __m256i low_rot = _mm256_permutevar8x32_epi32(
+    x_low, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+  __m256i high_rot = _mm256_permutevar8x32_epi32(
+    x_high, _mm256_setr_epi32(2, 0, 1, 3, 3, 3, 3, 3));
+  *low = _mm256_add_epi32(*low, _mm256_blend_epi32(low_rot, high_rot, 0x01));
+  *high = _mm256_add_epi32(
+    *high, _mm256_blend_epi32(high_rot, low_rot, 0x01));
+}
 
-  residue_narrow_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[0];
-  }
+// Carry from every limb of at least t to the limb above. With limbs in
+// [0, 2t), this leaves them in [0, t].
+static inline void carry_from_t(__m256i *low, __m256i *high) {
+  __m256i t = _mm256_set1_epi32(T);
+  __m256i t_minus_one = _mm256_set1_epi32(T - 1);
+  __m256i carry_low = _mm256_cmpgt_epi32(*low, t_minus_one);
+  __m256i carry_high = _mm256_cmpgt_epi32(*high, t_minus_one);
+  *low = _mm256_sub_epi32(*low, _mm256_and_si256(carry_low, t));
+  *high = _mm256_sub_epi32(*high, _mm256_and_si256(carry_high, t));
+  add_rotated(low, high, _mm256_sub_epi32(_mm256_setzero_si256(), carry_low),
+    _mm256_sub_epi32(_mm256_setzero_si256(), carry_high));
+}
 
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
+// Reduce to the unique representative, as in ref. See carry_mask.h
+static inline void complete_vec(__m256i *low, __m256i *high) {
+  // reduce_step_narrow, in this layout.
+  __m256i mask = _mm256_set1_epi32(TMASK);
+  __m256i carry_low = _mm256_srai_epi32(*low, TBITS);
+  __m256i carry_high = _mm256_srai_epi32(*high, TBITS);
+  *low = _mm256_and_si256(*low, mask);
+  *high = _mm256_and_si256(*high, mask);
+  *low = _mm256_add_epi32(*low, _mm256_sub_epi32(
+    _mm256_slli_epi32(carry_low, T_CBITS), carry_low));
+  *high = _mm256_add_epi32(*high, _mm256_sub_epi32(
+    _mm256_slli_epi32(carry_high, T_CBITS), carry_high));
+  add_rotated(low, high, carry_low, carry_high);
+
+  // Base t digits of a value congruent to x, in 11 limbs each in [0, t).
+  __m256i offset = _mm256_set1_epi32(COMPLETE_OFFSET);
+  *low = _mm256_add_epi32(*low, offset);
+  *high = _mm256_add_epi32(*high, offset);
+  carry_from_t(low, high);
+  uint32_t carry_in = carry_in_mask_cyclic(
+    limbs_equal(*low, *high, T), limbs_equal(*low, *high, T - 1));
+  add_limbs_masked(low, high, carry_in, 1);
+  add_limbs_masked(low, high, carry_out_mask_cyclic(carry_in), -T);
+
+  // Subtract digit 10 times p and add p back, leaving a value in (0, 2p).
+  __m256i x10 = _mm256_permutevar8x32_epi32(*high, _mm256_set1_epi32(2));
+  *low = _mm256_add_epi32(_mm256_sub_epi32(*low, x10),
+    _mm256_setr_epi32(T + 1, T, T, T, T, T, T, T));
+  *high = _mm256_add_epi32(_mm256_sub_epi32(*high, x10),
+    _mm256_setr_epi32(T, T, 0, 0, 0, 0, 0, 0));
+  carry_from_t(low, high);
+  carry_in = carry_in_mask(
+    limbs_equal(*low, *high, T) & REDUCED_DIGITS_MASK,
+    limbs_equal(*low, *high, T - 1) & REDUCED_DIGITS_MASK);
+  add_limbs_masked(low, high, carry_in, 1);
+  add_limbs_masked(low, high, carry_in >> 1, -T);
+
+  // Subtract p, or write the top digits as t.
+  complete_masks_t masks;
+  complete_masks(
+    &masks, limbs_equal(*low, *high, 1), limbs_equal(*low, *high, 0));
+  add_limbs_masked(low, high, masks.minus_one, -1);
+  add_limbs_masked(low, high, masks.borrow_in, -1);
+  add_limbs_masked(low, high, masks.borrow_out, T);
+  __m256i top_t_low, top_t_high;
+  expand_limb_mask(&top_t_low, &top_t_high, masks.top_t);
+  __m256i t = _mm256_set1_epi32(T);
+  *low = _mm256_blendv_epi8(*low, t, top_t_low);
+  *high = _mm256_blendv_epi8(*high, t, top_t_high);
+}
 
-  int gt_mask = 0;
-  int lt_mask = 0;
-  for (int i = 1; i < NLIMBS; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[0];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & gt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-  }
-  for (int i = 1; i < NLIMBS; ++i) {
-    temp.limbs[i] -= temp.limbs[11];
-  }
-  gt_mask = 0;
-  lt_mask = 0;
-  for (int i = 1; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i-1] = temp.limbs[i];
-  }
+static inline void load_complete(
+  __m256i *low, __m256i *high, const residue_narrow_t *x) {
+  *low = _mm256_loadu_si256((__m256i*) &x->limbs[1]);
+  *high = _mm256_zextsi128_si256(
+    _mm_srli_si128(_mm_load_si128((__m128i*) &x->limbs[8]), 4));
+}
+
+static inline void store_complete(
+  residue_narrow_reduced_t *result, __m256i low, __m256i high) {
+  _mm256_storeu_si256((__m256i*) &result->limbs[0], low);
+  _mm_storel_epi64(
+    (__m128i*) &result->limbs[8], _mm256_castsi256_si128(high));
+}
+
+// Reduce to unique representative.
+// Limbs are in [0, t), except that a value of at least t^10 has its top limbs
+// equal to t. Branch free.
+void narrow_complete(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+  __m256i low, high;
+  load_complete(&low, &high, w);
+  complete_vec(&low, &high);
+  store_complete(result, low, high);
+}
+
+// narrow_complete costs no more, so this is the complete form.
+void narrow_partial_complete(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+  narrow_complete(result, w);
+}
+
+void narrow_compress(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict x,
+  const residue_narrow_t * __restrict y) {
+  __m256i x_low, x_high, y_low, y_high;
+  load_complete(&x_low, &x_high, x);
+  load_complete(&y_low, &y_high, y);
+  complete_vec(&x_low, &x_high);
+  complete_vec(&y_low, &y_high);
+  uint32_t odd_limbs = limb_mask(
+    _mm256_slli_epi32(x_low, 31), _mm256_slli_epi32(x_high, 31));
+  int32_t x_is_odd = __builtin_popcount(odd_limbs & REDUCED_DIGITS_MASK) & 1;
+  store_complete(result, y_low, y_high);
+  result->limbs[NLIMBS_REDUCED - 1] |= x_is_odd << TBITS;
 }
 
 int is_odd(residue_narrow_reduced_t *x) {
@@ -256,6 +348,8 @@ void double_wide(
 // to 32 bits, but not narrowed for performance reasons.
 void mul_wide(
   residue_wide_t *result, const residue_wide_t *x, const residue_wide_t *y) {
+  CHECK_BOUNDS_WIDE(x);
+  CHECK_BOUNDS_WIDE(y);
 
   residue_wide_t temp;
 
@@ -469,6 +563,8 @@ static inline __m256i loadu_extend_32_64(__m128i *x) {
 // reduced to 32 bits, but not narrowed for performance reasons.
 void mul_wide_narrow(
   residue_wide_t *result, const residue_wide_t *x, const residue_narrow_t *y) {
+  CHECK_BOUNDS_WIDE(x);
+  CHECK_BOUNDS_NARROW(y);
 
   residue_wide_t temp;
 
@@ -675,6 +771,8 @@ void mul_wide_narrow(
 void mul_narrow(
   residue_wide_t *result, const residue_narrow_t *x,
   const residue_narrow_t *y) {
+  CHECK_BOUNDS_NARROW(x);
+  CHECK_BOUNDS_NARROW(y);
 
   residue_wide_t temp;
 
@@ -900,10 +998,246 @@ void mul_narrow_const(
   reduce_step_wide(result, &temp);
 }
 
+// Broadcast 64-bit lane i of v. Only the low 32 bits of each lane are used by
+// the multiplies, so this stands in for _mm256_set1_epi32.
+#define BROADCAST_SLOT(v, i) _mm256_permute4x64_epi64((v), (i) * 0x55)
+
+// Slots k + 1 through k + 4, given slots k through k + 7 in lo and hi.
+static inline __m256i slots_from_1(__m256i lo, __m256i hi) {
+  __m256i mid = _mm256_permute2x128_si256(lo, hi, 0x21);
+  return _mm256_alignr_epi8(mid, lo, 8);
+}
+
+// Slots k + 2 through k + 5, given slots k through k + 7 in lo and hi.
+static inline __m256i slots_from_2(__m256i lo, __m256i hi) {
+  return _mm256_permute2x128_si256(lo, hi, 0x21);
+}
+
+// Slots k + 3 through k + 6, given slots k through k + 7 in lo and hi.
+static inline __m256i slots_from_3(__m256i lo, __m256i hi) {
+  __m256i mid = _mm256_permute2x128_si256(lo, hi, 0x21);
+  return _mm256_alignr_epi8(hi, mid, 8);
+}
+
+// reduce_step_wide on the three registers of a wide residue, in place. See
+// square_wide_vec.
+static inline void reduce_step_wide_vec(
+  __m256i *limbs0, __m256i *limbs4, __m256i *limbs8) {
+
+  __m256i accum0, accum4, accum8;
+
+  __m256i logical_shift;
+  __m256i arithmetic_shift;
+  __m256i carry_rot0, carry_rot4, carry_rot8;
+  __m256i error0, error4, error8;
+  __m256i shift_error0, shift_error4, shift_error8;
+  __m256i merged_carry;
+  __m256i mask = _mm256_set1_epi64x(0x3ffffff);
+
+  accum8 = *limbs8;
+  logical_shift = _mm256_srli_epi64(accum8, 26);
+  arithmetic_shift = _mm256_srai_epi32(accum8, 26);
+  accum8 = _mm256_and_si256(accum8, mask);
+  error8 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
+  accum8 = _mm256_sub_epi64(accum8, error8);
+  carry_rot8 = _mm256_permute4x64_epi64(error8, 0x92);
+  shift_error8 = _mm256_slli_epi64(error8, 4);
+  accum8 = _mm256_add_epi64(accum8, shift_error8);
+
+  accum4 = *limbs4;
+  logical_shift = _mm256_srli_epi64(accum4, 26);
+  arithmetic_shift = _mm256_srai_epi32(accum4, 26);
+  accum4 = _mm256_and_si256(accum4, mask);
+  error4 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
+  accum4 = _mm256_sub_epi64(accum4, error4);
+  carry_rot4 = _mm256_permute4x64_epi64(error4, 0x93);
+  shift_error4 = _mm256_slli_epi64(error4, 4);
+  accum4 = _mm256_add_epi64(accum4, shift_error4);
+
+  merged_carry = _mm256_blend_epi32(carry_rot8, carry_rot4, 0x03);
+  accum8 = _mm256_add_epi64(accum8, merged_carry);
+  *limbs8 = accum8;
+
+  accum0 = *limbs0;
+  logical_shift = _mm256_srli_epi64(accum0, 26);
+  arithmetic_shift = _mm256_srai_epi32(accum0, 26);
+  accum0 = _mm256_and_si256(accum0, mask);
+  error0 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
+  accum0 = _mm256_sub_epi64(accum0, error0);
+  carry_rot0 = _mm256_permute4x64_epi64(error0, 0x93);
+
+  merged_carry = _mm256_blend_epi32(carry_rot4, carry_rot0, 0x03);
+  accum4 = _mm256_add_epi64(accum4, merged_carry);
+  *limbs4 = accum4;
+
+  shift_error0 = _mm256_slli_epi64(error0, 4);
+  accum0 = _mm256_add_epi64(accum0, shift_error0);
+
+  merged_carry = _mm256_blend_epi32(carry_rot0, carry_rot8, 0x03);
+  accum0 = _mm256_add_epi64(accum0, merged_carry);
+  *limbs0 = accum0;
+}
+
+// The schedule of square_wide on a residue held in three registers: limbs0
+// has slots 0-3, limbs4 slots 4-7 and limbs8 slots 8-11. The offset windows
+// and broadcasts are built from the registers with permutes rather than loaded
+// from memory, so a chain of squarings never round trips through the stack.
+static inline void square_wide_vec(
+  __m256i *limbs0, __m256i *limbs4, __m256i *limbs8) {
+  __m256i x0 = *limbs0, x4 = *limbs4, x8 = *limbs8;
+
+  __m256i sublhs, mul; // Temporaries for the actual sub sub mul
+  __m128i sublhs128_low7;
+  __m128i sublhs128_low3;
+  __m128i sublhs128_low10;
+  __m128i sublhs128_high; // Temporaries for single lane blends
+  __m256i accum7, accum3, accum10; // Three accumulators
+  accum7 = accum3 = accum10 = _mm256_setzero_si256();
+
+  // We do 7-10 first.
+  __m256i lhs_7_10 = x8;
+  __m256i lhs_0 = BROADCAST_SLOT(x0, 1);
+
+  // 0 * [7 8 9 10]
+  sublhs = _mm256_sub_epi32(lhs_0, lhs_7_10);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum7 = _mm256_sub_epi64(accum7, mul);
+
+  __m256i lhs_6_9 = slots_from_3(x4, x8);
+
+  __m256i lhs_1 = BROADCAST_SLOT(x0, 2);
+
+  // Second round is interleaved starting here
+  __m256i lhs_8 = BROADCAST_SLOT(x8, 1);
+
+  // 1 * [6 7 8 9]
+  sublhs = _mm256_sub_epi32(lhs_1, lhs_6_9);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum7 = _mm256_sub_epi64(accum7, mul);
+
+  // 8 * [6 7]
+  sublhs128_low3 = _mm_sub_epi32(_mm256_castsi256_si128(lhs_8),
+                                 _mm256_castsi256_si128(lhs_6_9));
+
+  __m256i lhs_5_8 = slots_from_2(x4, x8);
+  __m256i lhs_4 = BROADCAST_SLOT(x4, 1);
+  __m256i lhs_2 = BROADCAST_SLOT(x0, 3);
+  __m256i lhs_9 = BROADCAST_SLOT(x8, 2);
+
+  // 2 * [5 6 7 8]
+  sublhs = _mm256_sub_epi32(lhs_2, lhs_5_8);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum7 = _mm256_sub_epi64(accum7, mul);
+
+  // 9 * [5 6 7 8]
+  sublhs = _mm256_sub_epi32(lhs_9, lhs_5_8);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum3 = _mm256_sub_epi64(accum3, mul);
+
+  __m256i lhs_4_7 = slots_from_1(x4, x8);
+  __m256i lhs_10 = BROADCAST_SLOT(x0, 0);
+  __m256i lhs_3 = BROADCAST_SLOT(x4, 0);
+
+  // Third round is interleaved starting here
+  __m256i lhs_6 = BROADCAST_SLOT(x4, 3);
+
+  // 3 * [4 5 6 7]
+  sublhs = _mm256_sub_epi32(lhs_3, lhs_4_7);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum7 = _mm256_sub_epi64(accum7, mul);
+
+  // 10 * [4 5 6 7]
+  sublhs = _mm256_sub_epi32(lhs_10, lhs_4_7);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum3 = _mm256_sub_epi64(accum3, mul);
+
+  // 6 * [4 5]
+  sublhs128_low10 = _mm_sub_epi32(_mm256_castsi256_si128(lhs_6),
+                                  _mm256_castsi256_si128(lhs_4_7));
+
+  __m256i lhs_3_6 = x4;
+  __m256i lhs_7 = BROADCAST_SLOT(x8, 0);
+
+  // 0 * [3 4 5 6]
+  sublhs = _mm256_sub_epi32(lhs_0, lhs_3_6);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum3 = _mm256_sub_epi64(accum3, mul);
+
+  // 7 * [3 4 5 6]
+  sublhs = _mm256_sub_epi32(lhs_7, lhs_3_6);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum10 = _mm256_sub_epi64(accum10, mul);
+
+  // 4 * [5 6], 10 * [8 9]
+  __m128i lhs_8_9 = _mm256_extracti128_si256(lhs_6_9, 1);
+
+  sublhs128_low7 = _mm_sub_epi32(_mm256_castsi256_si128(lhs_10), lhs_8_9);
+
+  sublhs = _mm256_sub_epi32(lhs_4, lhs_3_6);
+  sublhs = _mm256_blend_epi32(
+      sublhs, _mm256_castsi128_si256(sublhs128_low7), 0x0f);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum7 = _mm256_sub_epi64(accum7, mul);
+
+  // Round 1 drops off here.
+  *limbs8 = accum7;
+
+  __m256i lhs_2_5 = slots_from_3(x0, x4);
+
+  // 1 * [2 3 4 5]
+  sublhs = _mm256_sub_epi32(lhs_1, lhs_2_5);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum3 = _mm256_sub_epi64(accum3, mul);
+
+  // 8 * [2 3 4 5]
+  sublhs = _mm256_sub_epi32(lhs_8, lhs_2_5);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum10 = _mm256_sub_epi64(accum10, mul);
+
+  __m256i lhs_1_4 = slots_from_2(x0, x4);
+
+  // 9 * [1 2 3 4]
+  sublhs = _mm256_sub_epi32(lhs_9, lhs_1_4);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum10 = _mm256_sub_epi64(accum10, mul);
+
+  // 0 * [1 2]
+  // We do this here, only because we never load [10 0 1 2]
+  sublhs128_high = _mm_sub_epi32(_mm256_castsi256_si128(lhs_0),
+                                 _mm256_castsi256_si128(lhs_1_4));
+  sublhs = _mm256_inserti128_si256(
+    _mm256_castsi128_si256(sublhs128_low10),
+    sublhs128_high, 1);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum10 = _mm256_sub_epi64(accum10, mul);
+
+  // 2 * [3 4]
+  sublhs = _mm256_sub_epi32(lhs_2, lhs_1_4);
+  sublhs = _mm256_blend_epi32(
+      sublhs, _mm256_castsi128_si256(sublhs128_low3), 0x0f);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum3 = _mm256_sub_epi64(accum3, mul);
+  // Round 2 drops off here.
+  *limbs4 = accum3;
+
+  __m256i lhs_0_3 = slots_from_1(x0, x4);
+
+  // 10 * [0 1 2 3]
+  sublhs = _mm256_sub_epi32(lhs_10, lhs_0_3);
+  mul = _mm256_mul_epi32(sublhs, sublhs);
+  accum10 = _mm256_sub_epi64(accum10, mul);
+  // Round 3 drops off here.
+
+  *limbs0 = accum10;
+  reduce_step_wide_vec(limbs0, limbs4, limbs8);
+  reduce_step_wide_vec(limbs0, limbs4, limbs8);
+}
+
 // Square a wide residue and produce a wide result. The result is reduced to 32
 // bits but not narrowed for performance reasons.
 void square_wide(
   residue_wide_t *result, const residue_wide_t *x) {
+  CHECK_BOUNDS_WIDE(x);
 
   residue_wide_t temp;
 
@@ -1058,6 +1392,7 @@ void square_wide(
 // 32 bits but not narrowed for performance reasons.
 void square_narrow(
   residue_wide_t *result, const residue_narrow_t *x) {
+  CHECK_BOUNDS_NARROW(x);
 
   residue_wide_t temp;
 
@@ -1253,59 +1588,13 @@ void reduce_step_narrow(
 // Approximately divide each coefficient by t. Carry the results.
 void reduce_step_wide(
   residue_wide_t *result, const residue_wide_t *x) {
-
-  __m256i accum0, accum4, accum8;
-
-  __m256i logical_shift;
-  __m256i arithmetic_shift;
-  __m256i carry_rot0, carry_rot4, carry_rot8;
-  __m256i error0, error4, error8;
-  __m256i shift_error0, shift_error4, shift_error8;
-  __m256i merged_carry;
-  __m256i mask = _mm256_set1_epi64x(0x3ffffff);
-
-  accum8 = _mm256_load_si256((__m256i*) &x->limbs[8]);
-  logical_shift = _mm256_srli_epi64(accum8, 26);
-  arithmetic_shift = _mm256_srai_epi32(accum8, 26);
-  accum8 = _mm256_and_si256(accum8, mask);
-  error8 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
-  accum8 = _mm256_sub_epi64(accum8, error8);
-  carry_rot8 = _mm256_permute4x64_epi64(error8, 0x92);
-  shift_error8 = _mm256_slli_epi64(error8, 4);
-  accum8 = _mm256_add_epi64(accum8, shift_error8);
-
-  accum4 = _mm256_load_si256((__m256i*) &x->limbs[4]);
-  logical_shift = _mm256_srli_epi64(accum4, 26);
-  arithmetic_shift = _mm256_srai_epi32(accum4, 26);
-  accum4 = _mm256_and_si256(accum4, mask);
-  error4 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
-  accum4 = _mm256_sub_epi64(accum4, error4);
-  carry_rot4 = _mm256_permute4x64_epi64(error4, 0x93);
-  shift_error4 = _mm256_slli_epi64(error4, 4);
-  accum4 = _mm256_add_epi64(accum4, shift_error4);
-
-  merged_carry = _mm256_blend_epi32(carry_rot8, carry_rot4, 0x03);
-  accum8 = _mm256_add_epi64(accum8, merged_carry);
-  _mm256_store_si256((__m256i*) &result->limbs[8], accum8);
-
-  accum0 = _mm256_load_si256((__m256i*) &x->limbs[0]);
-  logical_shift = _mm256_srli_epi64(accum0, 26);
-  arithmetic_shift = _mm256_srai_epi32(accum0, 26);
-  accum0 = _mm256_and_si256(accum0, mask);
-  error0 = _mm256_blend_epi32(logical_shift, arithmetic_shift, 0xaa);
-  accum0 = _mm256_sub_epi64(accum0, error0);
-  carry_rot0 = _mm256_permute4x64_epi64(error0, 0x93);
-
-  merged_carry = _mm256_blend_epi32(carry_rot4, carry_rot0, 0x03);
-  accum4 = _mm256_add_epi64(accum4, merged_carry);
-  _mm256_store_si256((__m256i*) &result->limbs[4], accum4);
-
-  shift_error0 = _mm256_slli_epi64(error0, 4);
-  accum0 = _mm256_add_epi64(accum0, shift_error0);
-
-  merged_carry = _mm256_blend_epi32(carry_rot0, carry_rot8, 0x03);
-  accum0 = _mm256_add_epi64(accum0, merged_carry);
-  _mm256_store_si256((__m256i*) &result->limbs[0], accum0);
+  __m256i limbs0 = _mm256_load_si256((__m256i*) &x->limbs[0]);
+  __m256i limbs4 = _mm256_load_si256((__m256i*) &x->limbs[4]);
+  __m256i limbs8 = _mm256_load_si256((__m256i*) &x->limbs[8]);
+  reduce_step_wide_vec(&limbs0, &limbs4, &limbs8);
+  _mm256_store_si256((__m256i*) &result->limbs[0], limbs0);
+  _mm256_store_si256((__m256i*) &result->limbs[4], limbs4);
+  _mm256_store_si256((__m256i*) &result->limbs[8], limbs8);
 }
 
 // Takes advantage of the fact that if a residue z *is zero* then after setting
@@ -1344,13 +1633,21 @@ int equal_narrow_reduced(
   return !result;
 }
 
+// Square x n times. The residue stays in registers for the whole chain, so
+// only x has its bounds checked.
 static inline void nsquare_wide(
   residue_wide_t *result, const residue_wide_t *x, int n) {
+  CHECK_BOUNDS_WIDE(x);
 
-  square_wide(result, x);
-  for (int i = 1; i < n; ++i) {
-    square_wide(result, result);
+  __m256i limbs0 = _mm256_load_si256((__m256i*) &x->limbs[0]);
+  __m256i limbs4 = _mm256_load_si256((__m256i*) &x->limbs[4]);
+  __m256i limbs8 = _mm256_load_si256((__m256i*) &x->limbs[8]);
+  for (int i = 0; i < n; ++i) {
+    square_wide_vec(&limbs0, &limbs4, &limbs8);
   }
+  _mm256_store_si256((__m256i*) &result->limbs[0], limbs0);
+  _mm256_store_si256((__m256i*) &result->limbs[4], limbs4);
+  _mm256_store_si256((__m256i*) &result->limbs[8], limbs8);
 }
 
 static void raise_to_t(
@@ -1487,7 +1784,7 @@ int sqrt_inv_wide(
   return equal_wide(&should_be_x, x);
 }
 
-void invert_wide(
+void invert_wide_fermat(
   residue_wide_t *result, const residue_wide_t * __restrict x) {
 
   residue_wide_t x_t_minus_1_over_4;
@@ -1514,6 +1811,97 @@ void invert_wide(
   mul_wide(result, &result_t, &x_t_minus_1);
 }
 
+// Limb 10 is in slots 0 and 11. divsteps wants the limbs in order.
+static void to_divsteps_digits(
+  int32_t digits[DIVSTEPS_DIGITS], const residue_wide_t *x) {
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    digits[i] = x->limbs[i + 1];
+  }
+  digits[NLIMBS_REDUCED] = x->limbs[0];
+}
+
+static void from_divsteps_digits(
+  residue_wide_t *result, const int32_t digits[DIVSTEPS_DIGITS]) {
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    result->limbs[i + 1] = digits[i];
+  }
+  result->limbs[0] = digits[NLIMBS_REDUCED];
+  result->limbs[NLIMBS - 1] = digits[NLIMBS_REDUCED];
+}
+
+void invert_wide(
+  residue_wide_t *result, const residue_wide_t * __restrict x) {
+  int32_t digits[DIVSTEPS_DIGITS];
+
+  to_divsteps_digits(digits, x);
+  invert_divsteps(digits, digits);
+  from_divsteps_digits(result, digits);
+}
+
+void invert_wide_var(
+  residue_wide_t *result, const residue_wide_t * __restrict x) {
+  int32_t digits[DIVSTEPS_DIGITS];
+
+  to_divsteps_digits(digits, x);
+  invert_divsteps_var(digits, digits);
+  from_divsteps_digits(result, digits);
+}
+
+void invert_wide_batch(
+  residue_wide_t *out, const residue_wide_t *in, size_t n) {
+  residue_wide_t acc_inv;
+
+  if (n == 0) {
+    return;
+  }
+
+  // out[i] = in[0] * ... * in[i]
+  copy_wide(&out[0], &in[0]);
+  for (size_t i = 1; i < n; ++i) {
+    mul_wide(&out[i], &out[i - 1], &in[i]);
+  }
+
+  // acc_inv is the inverse of in[0] * ... * in[i]. Peel off one input per
+  // step.
+  invert_wide(&acc_inv, &out[n - 1]);
+  for (size_t i = n - 1; i > 0; --i) {
+    mul_wide(&out[i], &acc_inv, &out[i - 1]);
+    mul_wide(&acc_inv, &acc_inv, &in[i]);
+  }
+  copy_wide(&out[0], &acc_inv);
+}
+
+void invert_narrow_batch(
+  residue_narrow_t *out, const residue_narrow_t *in, size_t n) {
+  residue_wide_t temp;
+  residue_wide_t acc_inv_wide;
+  residue_narrow_t acc_inv;
+
+  if (n == 0) {
+    return;
+  }
+
+  // out[i] = in[0] * ... * in[i]
+  copy_narrow(&out[0], &in[0]);
+  for (size_t i = 1; i < n; ++i) {
+    mul_narrow(&temp, &out[i - 1], &in[i]);
+    narrow(&out[i], &temp);
+  }
+
+  // acc_inv is the inverse of in[0] * ... * in[i]. Peel off one input per
+  // step.
+  widen(&temp, &out[n - 1]);
+  invert_wide(&acc_inv_wide, &temp);
+  narrow(&acc_inv, &acc_inv_wide);
+  for (size_t i = n - 1; i > 0; --i) {
+    mul_narrow(&temp, &acc_inv, &out[i - 1]);
+    narrow(&out[i], &temp);
+    mul_narrow(&temp, &acc_inv, &in[i]);
+    narrow(&acc_inv, &temp);
+  }
+  copy_narrow(&out[0], &acc_inv);
+}
+
 void encode(uint8_t *out, const residue_narrow_reduced_t * __restrict x) {
   uint32_t collect = x->limbs[0];
 
@@ -2,6 +2,7 @@
 
 #ifndef F11_260_H
 #define F11_260_H
+#include <stddef.h>
 #include <stdint.h>
 
 #define NLIMBS_REDUCED 10
@@ -36,6 +37,26 @@ residue_wide_t one_wide;
 residue_narrow_t zero_narrow;
 residue_narrow_t one_narrow;
 
+// Multiplies take differences of limbs in 32 bits, and add up 5 products of
+// differences in 64 bits. Both fit if every input limb is at most
+// MUL_LIMB_BOUND in absolute value: 5 * (2 * 2^29)^2 < 2^63. Products come out
+// with limbs in (-2^19, 2^26 + 2^19), so a sum or difference of up to 7
+// products can be multiplied without a reduce step. Add, subtract, negate and
+// double never reduce; it is up to the caller to stay within the bound.
+#define MUL_LIMB_BOUND (1 << 29)
+
+#ifdef FIELD_BOUNDS_CHECK
+// Assert that every limb of x is within MUL_LIMB_BOUND. Called on the inputs of
+// every multiply and square. make debug turns this on.
+void check_bounds_narrow(const residue_narrow_t *x);
+void check_bounds_wide(const residue_wide_t *x);
+#define CHECK_BOUNDS_NARROW(x) check_bounds_narrow(x)
+#define CHECK_BOUNDS_WIDE(x) check_bounds_wide(x)
+#else
+#define CHECK_BOUNDS_NARROW(x)
+#define CHECK_BOUNDS_WIDE(x)
+#endif
+
 // Shrink to 32 bits. Assumes reduction has already occurred, and wide storage
 // is being used for vector compatibility.
 void narrow(residue_narrow_t *result, const residue_wide_t * __restrict w);
@@ -45,7 +66,8 @@ void narrow_reduce(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w);
 
 // Reduce to unique representative.
-// This is expensive. Only used for final signature or DH Key
+// Limbs are in [0, t), except that a value of at least t^10 has its top limbs
+// equal to t. Branch free. Used for final signature, keys, or DH Key
 void narrow_complete(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w);
 
@@ -53,10 +75,17 @@ void narrow_complete(
 // All coefficients are reduced to 0 <= xi <= t
 // Unique up to carries (xi == t) => (xi = 0; x[i+1] += 1);
 // This is sufficient to determine if x is even or odd.
-// Still pretty expensive. Used in point compression.
+// Currently the same as narrow_complete, which costs no more.
 void narrow_partial_complete(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w);
 
+// The compressed form of the affine point (x, y): y reduced to its unique
+// representative, with the parity of x in bit TBITS of the top limb. Does both
+// reductions in one pass.
+void narrow_compress(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict x,
+  const residue_narrow_t * __restrict y);
+
 int is_odd(residue_narrow_reduced_t *x);
 
 // Produce a 32-bit entry with 11 limbs
@@ -150,10 +179,29 @@ void reduce_step_narrow(
 void reduce_step_wide(
   residue_wide_t *result, const residue_wide_t *x);
 
-// Invert via fermat's theorem
+// Invert via divsteps. Constant time.
 void invert_wide(
   residue_wide_t *result, const residue_wide_t * __restrict x);
 
+// Invert via divsteps, in variable time. Only for public values, such as in
+// verification.
+void invert_wide_var(
+  residue_wide_t *result, const residue_wide_t * __restrict x);
+
+// Invert via fermat's theorem. Kept as a reference for the divsteps version.
+void invert_wide_fermat(
+  residue_wide_t *result, const residue_wide_t * __restrict x);
+
+// Invert n residues with a single inversion, using Montgomery's trick. Costs
+// 3(n - 1) multiplications plus one inversion. out and in must not overlap.
+// None of the inputs may be zero.
+void invert_wide_batch(
+  residue_wide_t *out, const residue_wide_t *in, size_t n);
+
+// Narrow storage version of invert_wide_batch.
+void invert_narrow_batch(
+  residue_narrow_t *out, const residue_narrow_t *in, size_t n);
+
 // Compute combined inverse and square root
 // returns true if x/y was a quadratic residue, and false otherwise.
 int sqrt_inv_wide(
@@ -0,0 +1,244 @@
+#include <stdint.h>
+#include "f11_260.h"
+#include "f11_260_x4.h"
+#include "immintrin.h"
+
+#ifdef FIELD_BOUNDS_CHECK
+#include <assert.h>
+
+// The vertical multiplies have the same bounds as the scalar ones. See
+// MUL_LIMB_BOUND.
+static void check_bounds_x4(const residue_x4_t *x) {
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    for (int j = 0; j < LANES_X4; ++j) {
+      assert(x->limbs[i][j] >= -MUL_LIMB_BOUND &&
+             x->limbs[i][j] <= MUL_LIMB_BOUND);
+    }
+  }
+}
+#define CHECK_BOUNDS_X4(x) check_bounds_x4(x)
+#else
+#define CHECK_BOUNDS_X4(x)
+#endif
+
+__attribute__((__aligned__(32)))
+static const int32_t COLLAPSE_X4[8] = { 0, 2, 4, 6, 0, 2, 4, 6 };
+
+// Transpose four rows of four 32-bit limbs, one row per element, into four
+// limbs of four sign extended lanes, and store them at result[0 .. 3].
+static inline void transpose_store_x4(
+  int64_t (*result)[LANES_X4], __m128i r0, __m128i r1, __m128i r2,
+  __m128i r3) {
+  __m128i r01_low = _mm_unpacklo_epi32(r0, r1);
+  __m128i r23_low = _mm_unpacklo_epi32(r2, r3);
+  __m128i r01_high = _mm_unpackhi_epi32(r0, r1);
+  __m128i r23_high = _mm_unpackhi_epi32(r2, r3);
+  _mm256_store_si256((__m256i*) result[0],
+    _mm256_cvtepi32_epi64(_mm_unpacklo_epi64(r01_low, r23_low)));
+  _mm256_store_si256((__m256i*) result[1],
+    _mm256_cvtepi32_epi64(_mm_unpackhi_epi64(r01_low, r23_low)));
+  _mm256_store_si256((__m256i*) result[2],
+    _mm256_cvtepi32_epi64(_mm_unpacklo_epi64(r01_high, r23_high)));
+  _mm256_store_si256((__m256i*) result[3],
+    _mm256_cvtepi32_epi64(_mm_unpackhi_epi64(r01_high, r23_high)));
+}
+
+// Narrow and wide residues keep limb 10 in slot 0, and limbs 0-9 in slots 1-10.
+// Slot 11 is also limb 10, so limbs 0-10 are in slots 1-11, and can be moved
+// four at a time. The last group overlaps the second by one limb.
+void pack_x4(
+  residue_x4_t *result, const residue_narrow_t *x0,
+  const residue_narrow_t *x1, const residue_narrow_t *x2,
+  const residue_narrow_t *x3) {
+
+  static const int GROUPS[3] = {0, 4, 7};
+  for (int g = 0; g < 3; ++g) {
+    int i = GROUPS[g];
+    transpose_store_x4(&result->limbs[i],
+      _mm_loadu_si128((__m128i*) &x0->limbs[i + 1]),
+      _mm_loadu_si128((__m128i*) &x1->limbs[i + 1]),
+      _mm_loadu_si128((__m128i*) &x2->limbs[i + 1]),
+      _mm_loadu_si128((__m128i*) &x3->limbs[i + 1]));
+  }
+}
+
+void pack_x4_wide(
+  residue_x4_t *result, const residue_wide_t *x0,
+  const residue_wide_t *x1, const residue_wide_t *x2,
+  const residue_wide_t *x3) {
+
+  const residue_wide_t *x[LANES_X4] = {x0, x1, x2, x3};
+  for (int j = 0; j < LANES_X4; ++j) {
+    for (int i = 0; i < NLIMBS_X4 - 1; ++i) {
+      result->limbs[i][j] = x[j]->limbs[i + 1];
+    }
+    result->limbs[NLIMBS_X4 - 1][j] = x[j]->limbs[0];
+  }
+}
+
+// The inverse of pack_x4. The low halves of the lanes of four limbs are
+// collected into rows, and the rows transposed back into elements.
+void unpack_x4(residue_narrow_t result[LANES_X4], const residue_x4_t *x) {
+  static const int GROUPS[3] = {0, 4, 7};
+  __m256i collapse = _mm256_load_si256((__m256i*) COLLAPSE_X4);
+  for (int g = 0; g < 3; ++g) {
+    int i = GROUPS[g];
+    __m128i r[4];
+    for (int k = 0; k < 4; ++k) {
+      r[k] = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+        _mm256_load_si256((__m256i*) x->limbs[i + k]), collapse));
+    }
+    __m128i r01_low = _mm_unpacklo_epi32(r[0], r[1]);
+    __m128i r23_low = _mm_unpacklo_epi32(r[2], r[3]);
+    __m128i r01_high = _mm_unpackhi_epi32(r[0], r[1]);
+    __m128i r23_high = _mm_unpackhi_epi32(r[2], r[3]);
+    _mm_storeu_si128((__m128i*) &result[0].limbs[i + 1],
+      _mm_unpacklo_epi64(r01_low, r23_low));
+    _mm_storeu_si128((__m128i*) &result[1].limbs[i + 1],
+      _mm_unpackhi_epi64(r01_low, r23_low));
+    _mm_storeu_si128((__m128i*) &result[2].limbs[i + 1],
+      _mm_unpacklo_epi64(r01_high, r23_high));
+    _mm_storeu_si128((__m128i*) &result[3].limbs[i + 1],
+      _mm_unpackhi_epi64(r01_high, r23_high));
+  }
+  for (int j = 0; j < LANES_X4; ++j) {
+    result[j].limbs[0] = result[j].limbs[NLIMBS - 1];
+  }
+}
+
+void unpack_x4_wide(residue_wide_t result[LANES_X4], const residue_x4_t *x) {
+  for (int j = 0; j < LANES_X4; ++j) {
+    for (int i = 0; i < NLIMBS_X4 - 1; ++i) {
+      result[j].limbs[i + 1] = x->limbs[i][j];
+    }
+    result[j].limbs[0] = result[j].limbs[NLIMBS - 1] =
+      x->limbs[NLIMBS_X4 - 1][j];
+  }
+}
+
+void add_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y) {
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i lhs = _mm256_load_si256((__m256i*) x->limbs[i]);
+    __m256i rhs = _mm256_load_si256((__m256i*) y->limbs[i]);
+    _mm256_store_si256(
+      (__m256i*) result->limbs[i], _mm256_add_epi64(lhs, rhs));
+  }
+}
+
+void sub_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y) {
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    __m256i lhs = _mm256_load_si256((__m256i*) x->limbs[i]);
+    __m256i rhs = _mm256_load_si256((__m256i*) y->limbs[i]);
+    _mm256_store_si256(
+      (__m256i*) result->limbs[i], _mm256_sub_epi64(lhs, rhs));
+  }
+}
+
+// There is no 64-bit arithmetic shift in AVX2. The low half of a logical shift
+// and the high half of a 32-bit arithmetic shift combine to form one.
+static inline __m256i srai26_epi64(__m256i x) {
+  return _mm256_blend_epi32(
+    _mm256_srli_epi64(x, TBITS), _mm256_srai_epi32(x, TBITS), 0xaa);
+}
+
+// Because each limb is in its own vector, the carry from limb i to limb i + 1
+// needs no permutes. The loops in the kernels below are unrolled so that the
+// limbs stay in registers.
+static inline void reduce_step_vectors(__m256i accum[NLIMBS_X4]) {
+  __m256i mask = _mm256_set1_epi64x(TMASK);
+  __m256i carries[NLIMBS_X4];
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    carries[i] = srai26_epi64(accum[i]);
+    accum[i] = _mm256_and_si256(accum[i], mask);
+    accum[i] = _mm256_add_epi64(
+      accum[i], _mm256_slli_epi64(carries[i], T_CBITS));
+    accum[i] = _mm256_sub_epi64(accum[i], carries[i]);
+  }
+  #pragma clang loop unroll(full)
+  for (int i = 1; i < NLIMBS_X4; ++i) {
+    accum[i] = _mm256_add_epi64(accum[i], carries[i - 1]);
+  }
+  accum[0] = _mm256_add_epi64(accum[0], carries[NLIMBS_X4 - 1]);
+}
+
+void reduce_step_x4(residue_x4_t *result, const residue_x4_t *x) {
+  __m256i accum[NLIMBS_X4];
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    accum[i] = _mm256_load_si256((__m256i*) x->limbs[i]);
+  }
+  reduce_step_vectors(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    _mm256_store_si256((__m256i*) result->limbs[i], accum[i]);
+  }
+}
+
+// Limbs of x, repeated so that limbs i - 5 through i + 5 of limb i can be
+// indexed without wrapping: result[k + 5] is limb k of x, for -5 <= k < 16.
+static inline void load_extended_x4(
+  __m256i result[NLIMBS_X4 + 10], const residue_x4_t *x) {
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4 + 10; ++i) {
+    result[i] = _mm256_load_si256(
+      (__m256i*) x->limbs[(i + NLIMBS_X4 - 5) % NLIMBS_X4]);
+  }
+}
+
+// The same schedule as the ref backend's mul_narrow, with one element per
+// lane. The 32-bit differences are sign extended by _mm256_mul_epi32.
+void mul_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y) {
+  CHECK_BOUNDS_X4(x);
+  CHECK_BOUNDS_X4(y);
+
+  __m256i lhs[NLIMBS_X4 + 10], rhs[NLIMBS_X4 + 10];
+  __m256i accum[NLIMBS_X4];
+  load_extended_x4(lhs, x);
+  load_extended_x4(rhs, y);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    int i_2 = ((i + (-(i & 1) & NLIMBS_X4)) >> 1) + 5;
+    accum[i] = _mm256_setzero_si256();
+    #pragma clang loop unroll(full)
+    for (int j = 1; j <= NLIMBS_X4 / 2; ++j) {
+      __m256i sublhs = _mm256_sub_epi32(lhs[i_2 + j], lhs[i_2 - j]);
+      __m256i subrhs = _mm256_sub_epi32(rhs[i_2 - j], rhs[i_2 + j]);
+      accum[i] = _mm256_add_epi64(
+        accum[i], _mm256_mul_epi32(sublhs, subrhs));
+    }
+  }
+  reduce_step_vectors(accum);
+  reduce_step_vectors(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    _mm256_store_si256((__m256i*) result->limbs[i], accum[i]);
+  }
+}
+
+void square_x4(residue_x4_t *result, const residue_x4_t *x) {
+  CHECK_BOUNDS_X4(x);
+  __m256i lhs[NLIMBS_X4 + 10];
+  __m256i accum[NLIMBS_X4];
+  load_extended_x4(lhs, x);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    int i_2 = ((i + (-(i & 1) & NLIMBS_X4)) >> 1) + 5;
+    accum[i] = _mm256_setzero_si256();
+    #pragma clang loop unroll(full)
+    for (int j = 1; j <= NLIMBS_X4 / 2; ++j) {
+      __m256i sub = _mm256_sub_epi32(lhs[i_2 + j], lhs[i_2 - j]);
+      accum[i] = _mm256_sub_epi64(accum[i], _mm256_mul_epi32(sub, sub));
+    }
+  }
+  reduce_step_vectors(accum);
+  reduce_step_vectors(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_X4; ++i) {
+    _mm256_store_si256((__m256i*) result->limbs[i], accum[i]);
+  }
+}
@@ -0,0 +1,57 @@
+// Four independent field elements, stored limb by limb so that each 64-bit
+// lane of a vector holds a different element. Every operation is applied to
+// all four elements at once, with no shuffling between lanes. Useful when there
+// are four unrelated multiplies to do in lockstep.
+
+#ifndef F11_260_X4_H
+#define F11_260_X4_H
+#include <stdint.h>
+#include "f11_260.h"
+
+#define NLIMBS_X4 11
+#define LANES_X4 4
+
+// limbs[i][j] is limb i of element j. Unlike the other wide and narrow
+// residues, limb 10 is stored only once, in limbs[10]. Reduced elements fit in
+// 32 bits, sign extended to 64.
+typedef struct residue_x4 {
+  __attribute__((__aligned__(32)))
+  int64_t limbs[NLIMBS_X4][LANES_X4];
+} residue_x4_t;
+
+// Gather four narrow residues into the lanes of result.
+void pack_x4(
+  residue_x4_t *result, const residue_narrow_t *x0,
+  const residue_narrow_t *x1, const residue_narrow_t *x2,
+  const residue_narrow_t *x3);
+
+// Gather four wide residues into the lanes of result.
+void pack_x4_wide(
+  residue_x4_t *result, const residue_wide_t *x0,
+  const residue_wide_t *x1, const residue_wide_t *x2,
+  const residue_wide_t *x3);
+
+// Scatter lane i of x into the narrow residue result[i].
+void unpack_x4(residue_narrow_t result[LANES_X4], const residue_x4_t *x);
+
+// Scatter lane i of x into the wide residue result[i].
+void unpack_x4_wide(residue_wide_t result[LANES_X4], const residue_x4_t *x);
+
+// Add each lane.
+void add_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y);
+
+// Subtract each lane.
+void sub_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y);
+
+// Multiply each lane. The result is reduced to 32 bits.
+void mul_x4(
+  residue_x4_t *result, const residue_x4_t *x, const residue_x4_t *y);
+
+// Square each lane. The result is reduced to 32 bits.
+void square_x4(residue_x4_t *result, const residue_x4_t *x);
+
+// Approximately divide each coefficient of each lane by t. Carry the results.
+void reduce_step_x4(residue_x4_t *result, const residue_x4_t *x);
+#endif
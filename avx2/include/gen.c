@@ -37,14 +37,60 @@ void gen_key(scalar_t * __restrict priv_key,
 
 void encode_pub_key(uint8_t *result, const affine_pt_narrow_t *pub_key) {
   residue_narrow_reduced_t y_reduced;
-  residue_narrow_reduced_t x_reduced;
-  narrow_complete(&y_reduced, &pub_key->y);
-  narrow_partial_complete(&x_reduced, &pub_key->x);
-
-  y_reduced.limbs[NLIMBS_REDUCED - 1] |= is_odd(&x_reduced) << TBITS;
+  narrow_compress(&y_reduced, &pub_key->x, &pub_key->y);
   encode(result, &y_reduced);
 }
 
+void point_compress(uint8_t *result, const projective_pt_wide_t *pt) {
+  residue_wide_t z_inv;
+  residue_wide_t temp;
+  affine_pt_narrow_t affine_pt;
+
+  invert_wide(&z_inv, &pt->z);
+  mul_wide(&temp, &pt->x, &z_inv);
+  narrow(&affine_pt.x, &temp);
+  mul_wide(&temp, &pt->y, &z_inv);
+  narrow(&affine_pt.y, &temp);
+  encode_pub_key(result, &affine_pt);
+
+  explicit_bzero(&z_inv, sizeof(z_inv));
+  explicit_bzero(&temp, sizeof(temp));
+  explicit_bzero(&affine_pt, sizeof(affine_pt));
+}
+
+void point_compress_batch(
+  uint8_t *result, const projective_pt_wide_t *pts, size_t n) {
+  residue_wide_t z[POINT_COMPRESS_BATCH];
+  residue_wide_t z_inv[POINT_COMPRESS_BATCH];
+  residue_wide_t temp;
+  affine_pt_narrow_t affine_pt;
+
+  for (size_t start = 0; start < n; start += POINT_COMPRESS_BATCH) {
+    size_t count = n - start;
+    if (count > POINT_COMPRESS_BATCH) {
+      count = POINT_COMPRESS_BATCH;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      copy_wide(&z[i], &pts[start + i].z);
+    }
+    invert_wide_batch(z_inv, z, count);
+
+    for (size_t i = 0; i < count; ++i) {
+      mul_wide(&temp, &pts[start + i].x, &z_inv[i]);
+      narrow(&affine_pt.x, &temp);
+      mul_wide(&temp, &pts[start + i].y, &z_inv[i]);
+      narrow(&affine_pt.y, &temp);
+      encode_pub_key(
+        result + (start + i) * RESIDUE_LENGTH_BYTES, &affine_pt);
+    }
+  }
+
+  explicit_bzero(z, sizeof(z));
+  explicit_bzero(z_inv, sizeof(z_inv));
+  explicit_bzero(&temp, sizeof(temp));
+  explicit_bzero(&affine_pt, sizeof(affine_pt));
+}
+
 int decode_pub_key(affine_pt_narrow_t *result, const uint8_t *encoded_key) {
   residue_narrow_reduced_t y_decoded;
   decode(&y_decoded, encoded_key);
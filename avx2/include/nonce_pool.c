@@ -0,0 +1 @@
+../../ref/include/nonce_pool.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/nonce_pool.h
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef SIGN_H
 #define SIGN_H
+#include <blake2.h>
+#include "comb.h"
 #include "curve.h"
+#include "key_cache.h"
 #include "scalar.h"
 
 #define SIG_LENGTH 65
@@ -13,11 +16,144 @@ typedef struct signature {
 void sign(signature_t *result, scalar_t *priv_key,
   const uint8_t *pub_key, const uint8_t *msg, size_t msg_len);
 
+// A key pair prepared for signing many messages, so that the secret key is
+// parsed and converted once rather than on every signature.
+typedef struct signing_ctx {
+  scalar_t priv_key;
+  // priv_key * (2^32)^17 mod l. A hash reduction leaves a factor of
+  // (2^32)^-8 and a montgomery multiply one of (2^32)^-9, so a single
+  // multiply of the reduced challenge hash by this gives h * priv_key.
+  scalar_t priv_key_mont;
+  uint8_t pub_key[RESIDUE_LENGTH_BYTES];
+  affine_pt_narrow_t pub_key_pt;
+} signing_ctx_t;
+
+// Parses a secret key: the private key in SCALAR_BYTES bytes followed by the
+// encoded public key. Returns 0 if the public key doesn't decode.
+int signing_ctx_init(signing_ctx_t *ctx, const uint8_t *secret_key);
+
+// Zeroizes ctx.
+void signing_ctx_destroy(signing_ctx_t *ctx);
+
+// Same as sign with the key pair in ctx.
+void sign_ctx(
+  signature_t *result, const signing_ctx_t *ctx, const uint8_t *msg,
+  size_t msg_len);
+
+// Same as verify with the public key in ctx.
+int verify_ctx(
+  const signing_ctx_t *ctx, const signature_t *sig, const uint8_t *msg,
+  size_t msg_len);
+
+// The message independent half of a signature: a session key and the encoded
+// R = session_key * B. Must be used for at most one signature, and zeroized
+// afterwards.
+typedef struct presignature {
+  scalar_t session_key;
+  uint8_t r_bytes[RESIDUE_LENGTH_BYTES];
+} presignature_t;
+
+// Computes a presignature for the key in ctx. This is the comb multiplication,
+// inversion and compression that dominate sign. The session key is derived
+// like sign's, from fresh randomness and the private key, but without the
+// message.
+void presign(presignature_t *result, const signing_ctx_t *ctx);
+
+// Completes a signature from a presignature made with the same key. Only
+// hashes the message and does a few scalar operations.
+void sign_presigned(
+  signature_t *result, const presignature_t *presig, const signing_ctx_t *ctx,
+  const uint8_t *msg, size_t msg_len);
+
+// Prehash mode signs a 64 byte digest of the message instead of the message,
+// so that the message is read only once, and can be hashed as it arrives. The
+// digest is the unkeyed 64 byte BLAKE2b of the message. The challenge hash is
+// keyed with a domain string, so a prehash signature is never valid for the
+// digest itself as a message.
+#define PREHASH_BYTES 64
+
+typedef struct sign_prehash {
+  blake2b_state hash_ctxt;
+} sign_prehash_t;
+
+void sign_prehash_init(sign_prehash_t *state);
+void sign_prehash_update(
+  sign_prehash_t *state, const uint8_t *chunk, size_t len);
+
+// Finishes the digest of the message, for verify_prehashed. Clears state.
+void sign_prehash_digest(uint8_t *digest, sign_prehash_t *state);
+
+// Signs the message hashed so far with the key pair in ctx. Clears state.
+void sign_prehash_final(
+  signature_t *result, sign_prehash_t *state, const signing_ctx_t *ctx);
+
+// Signs a digest of PREHASH_BYTES bytes computed elsewhere.
+void sign_prehashed(
+  signature_t *result, const signing_ctx_t *ctx, const uint8_t *digest);
+
+// Verifies sig for msg and the public key, given both encoded and decoded. The
+// check is cofactored: it accepts if sB + hA and R differ by a point of small
+// order, so that verify and verify_batch agree on every signature.
 int verify(
   const signature_t *sig, const uint8_t *r_bytes, const uint8_t *pub_key_bytes,
   const affine_pt_narrow_t *pub_key_pt, const uint8_t *msg,
   size_t msg_len);
 
+// Same as verify, for a prehash mode signature of the message with the given
+// digest.
+int verify_prehashed(
+  const signature_t *sig, const uint8_t *r_bytes, const uint8_t *pub_key_bytes,
+  const affine_pt_narrow_t *pub_key_pt, const uint8_t *digest);
+
+// Incremental verification. R and the public key come before the message in
+// the challenge hash, so the message can be hashed in pieces as it arrives,
+// without being buffered.
+typedef struct verify_stream {
+  blake2b_state hash_ctxt;
+  signature_t sig;
+  affine_pt_narrow_t pub_key_pt;
+  int pub_key_valid;
+} verify_stream_t;
+
+// Starts verifying sig against an encoded public key. A key that doesn't
+// decode makes verify_final fail.
+void verify_init(
+  verify_stream_t *state, const signature_t *sig,
+  const uint8_t *pub_key_bytes);
+void verify_update(verify_stream_t *state, const uint8_t *chunk, size_t len);
+
+// Same result as verify over the whole message.
+int verify_final(verify_stream_t *state);
+
+// Same as verify, but uses a precomputed comb set for the public key, so that
+// hA can be computed with the fast comb multiplication. Worthwhile when many
+// signatures are checked against the same key.
+int verify_with_comb(
+  const signature_t *sig, const uint8_t *r_bytes, const uint8_t *pub_key_bytes,
+  const sabs_comb_set_t *pub_key_comb, const uint8_t *msg, size_t msg_len);
+
+// Verifies against a public key given only in encoded form. Keys that are in
+// the cache, or that get admitted by this lookup, are checked with
+// verify_with_comb. Other keys are decoded and checked with verify.
+int verify_cached(
+  key_cache_t *cache, const signature_t *sig, const uint8_t *r_bytes,
+  const uint8_t *pub_key_bytes, const uint8_t *msg, size_t msg_len);
+
+// Verifies n signatures at once. The arguments are arrays of the arguments to
+// verify. Each signature is weighted by a random 128-bit coefficient and the
+// weighted equations are checked with a single multi-scalar multiplication.
+// The combined check is cofactored like verify's, so the two agree, except
+// with negligible probability over the coefficients. If the combined check
+// fails, each signature is checked individually. If valid is not NULL, valid[i]
+// is set to whether signature i verified. Returns 1 iff every signature is
+// valid.
+int verify_batch(
+  const signature_t *sigs, const uint8_t * const *r_bytes,
+  const uint8_t * const *pub_key_bytes,
+  const affine_pt_narrow_t * const *pub_key_pts,
+  const uint8_t * const *msgs, const size_t *msg_lens, size_t n,
+  int *valid);
+
 void encode_sig(uint8_t *result, const signature_t *sig);
 void decode_sig(signature_t *result, const uint8_t *encoded_sig);
 #endif
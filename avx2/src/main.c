@@ -5,11 +5,19 @@
 #include <string.h>
 #include "comb.h"
 #include "curve.h"
+#include "curve_x4.h"
 #include "f11_260.h"
+#include "f11_260_x4.h"
 #include "gen.h"
+#include "key_cache.h"
+#include "nonce_pool.h"
 #include "scalar.h"
 #include "sign.h"
 
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 int main(int _argc, char **argv) {
   residue_narrow_t x = {
     .limbs = {
@@ -88,14 +96,6 @@ int main(int _argc, char **argv) {
     },
   };
 
-  residue_narrow_reduced_t negative_t2_plus_one_partial = {
-    .limbs = {
-      0x3fffff1, 0x0000000, 0x3fffff1, 0x3fffff1,
-      0x3fffff1, 0x3fffff1, 0x3fffff1, 0x3fffff1,
-      0x3fffff1, 0x3fffff1,
-    },
-  };
-
   residue_narrow_reduced_t negative_t2_plus_one_complete = {
     .limbs = {
       0x0000000, 0x0000001, 0x3fffff1, 0x3fffff1,
@@ -156,6 +156,80 @@ int main(int _argc, char **argv) {
     assert(square_expected.limbs[i] == result.limbs[i]);
   }
 
+  // Each lane of the x4 kernels must agree with the single element versions.
+  residue_x4_t x4_lhs, x4_rhs, x4_result;
+  residue_narrow_t x4_narrow_lanes[LANES_X4];
+  residue_wide_t x4_lanes[LANES_X4];
+  residue_wide_t x4_expected[LANES_X4];
+  const residue_narrow_t *x4_inputs[LANES_X4] = {
+    &x, &y, &negative_one_redundant, &negative_t2_plus_one,
+  };
+  pack_x4(&x4_lhs, &x, &y, &negative_one_redundant, &negative_t2_plus_one);
+  pack_x4(&x4_rhs, &y, &negative_t2_plus_one, &x, &negative_one_redundant);
+  unpack_x4(x4_narrow_lanes, &x4_lhs);
+  for (int j = 0; j < LANES_X4; ++j) {
+    for (int i = 0; i < NLIMBS; ++i) {
+      assert(x4_inputs[j]->limbs[i] == x4_narrow_lanes[j].limbs[i]);
+    }
+  }
+
+  mul_x4(&x4_result, &x4_lhs, &x4_rhs);
+  unpack_x4_wide(x4_lanes, &x4_result);
+  mul_narrow(&x4_expected[0], &x, &y);
+  mul_narrow(&x4_expected[1], &y, &negative_t2_plus_one);
+  mul_narrow(&x4_expected[2], &negative_one_redundant, &x);
+  mul_narrow(&x4_expected[3], &negative_t2_plus_one, &negative_one_redundant);
+  for (int j = 0; j < LANES_X4; ++j) {
+    for (int i = 0; i < NLIMBS; ++i) {
+      assert(x4_expected[j].limbs[i] == x4_lanes[j].limbs[i]);
+    }
+  }
+
+  square_x4(&x4_result, &x4_lhs);
+  unpack_x4_wide(x4_lanes, &x4_result);
+  for (int j = 0; j < LANES_X4; ++j) {
+    square_narrow(&x4_expected[j], x4_inputs[j]);
+    for (int i = 0; i < NLIMBS; ++i) {
+      assert(x4_expected[j].limbs[i] == x4_lanes[j].limbs[i]);
+    }
+  }
+
+  add_x4(&x4_result, &x4_lhs, &x4_rhs);
+  sub_x4(&x4_result, &x4_result, &x4_rhs);
+  reduce_step_x4(&x4_result, &x4_result);
+  unpack_x4_wide(x4_lanes, &x4_result);
+  for (int j = 0; j < LANES_X4; ++j) {
+    widen(&x4_expected[j], x4_inputs[j]);
+    reduce_step_wide(&x4_expected[j], &x4_expected[j]);
+    for (int i = 0; i < NLIMBS; ++i) {
+      assert(x4_expected[j].limbs[i] == x4_lanes[j].limbs[i]);
+    }
+  }
+
+  // The lane parallel point formulas agree with the sequential ones.
+  {
+    extended_pt_wide_t pt_expected;
+    extended_pt_wide_t pt_result;
+    extended_pt_x4_t pt_x4;
+    affine_readd_to_extended(&pt_expected, &base_comb.combs[0].table[3]);
+    affine_readd_to_extended_x4(&pt_x4, &base_comb.combs[0].table[3]);
+    for (int k = 0; k < 4; ++k) {
+      extended_double_extended(&pt_expected, &pt_expected);
+      extended_double_extended_x4(&pt_x4, &pt_x4);
+      extended_readd_affine_narrow_extended(
+        &pt_expected, &pt_expected, &base_comb.combs[k].table[5 + k]);
+      extended_readd_affine_narrow_extended_x4(
+        &pt_x4, &pt_x4, &base_comb.combs[k].table[5 + k]);
+    }
+    x4_to_extended(&pt_result, &pt_x4);
+    for (int i = 0; i < NLIMBS; ++i) {
+      assert(pt_expected.x.limbs[i] == pt_result.x.limbs[i]);
+      assert(pt_expected.y.limbs[i] == pt_result.y.limbs[i]);
+      assert(pt_expected.z.limbs[i] == pt_result.z.limbs[i]);
+      assert(pt_expected.t.limbs[i] == pt_result.t.limbs[i]);
+    }
+  }
+
   // The reduction function doesn't reduce this redundant version of negative
   // one any more.
   reduce_step_narrow(&result_narrow, &negative_one_redundant);
@@ -168,11 +242,14 @@ int main(int _argc, char **argv) {
     assert(negative_t2_plus_one.limbs[i] == result_narrow.limbs[i]);
   }
 
+  // The partial form only has to agree with the complete form up to carries.
   narrow_partial_complete(&result_narrow_reduced, &negative_t2_plus_one);
   for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    assert(negative_t2_plus_one_partial.limbs[i] ==
-        result_narrow_reduced.limbs[i]);
+    assert(result_narrow_reduced.limbs[i] >= 0 &&
+        result_narrow_reduced.limbs[i] <= T);
   }
+  assert(is_odd(&result_narrow_reduced) ==
+      is_odd(&negative_t2_plus_one_complete));
 
   narrow_complete(&result_narrow_reduced, &negative_t2_plus_one);
   for (int i = 0; i < NLIMBS_REDUCED; ++i) {
@@ -180,6 +257,38 @@ int main(int _argc, char **argv) {
         result_narrow_reduced.limbs[i]);
   }
 
+  // Values at the edges of the unique representation. A value of at least
+  // t^10 has its top limbs equal to t.
+  residue_narrow_t p_redundant = {
+    .limbs = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+  };
+  residue_narrow_t minus_one = {
+    .limbs = {0, -1},
+  };
+  residue_narrow_t t_10 = {
+    .limbs = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+  };
+  narrow_complete(&result_narrow_reduced, &p_redundant);
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    assert(result_narrow_reduced.limbs[i] == 0);
+  }
+  narrow_complete(&result_narrow_reduced, &minus_one);
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    assert(result_narrow_reduced.limbs[i] == T);
+  }
+  narrow_complete(&result_narrow_reduced, &t_10);
+  for (int i = 0; i < NLIMBS_REDUCED - 1; ++i) {
+    assert(result_narrow_reduced.limbs[i] == 0);
+  }
+  assert(result_narrow_reduced.limbs[NLIMBS_REDUCED - 1] == T);
+
+  // t^10 is odd. Its parity goes above the top limb of y.
+  narrow_compress(&result_narrow_reduced, &t_10, &minus_one);
+  for (int i = 0; i < NLIMBS_REDUCED - 1; ++i) {
+    assert(result_narrow_reduced.limbs[i] == T);
+  }
+  assert(result_narrow_reduced.limbs[NLIMBS_REDUCED - 1] == (T | 1 << TBITS));
+
   scalar_t scalar_result;
   scalar_t scalar_x = {
     .limbs = {
@@ -339,6 +448,54 @@ int main(int _argc, char **argv) {
 
   invert_wide(&result, &x_wide);
   assert(equal_wide(&result, &x_inverse));
+  invert_wide_var(&result, &x_wide);
+  assert(equal_wide(&result, &x_inverse));
+  invert_wide_fermat(&result, &x_wide);
+  assert(equal_wide(&result, &x_inverse));
+
+  {
+    // Divsteps agrees with fermat.
+    residue_wide_t inputs[4];
+    residue_wide_t fermat;
+    copy_wide(&inputs[0], &x_wide);
+    copy_wide(&inputs[1], &y_wide);
+    copy_wide(&inputs[2], &x_plus_two);
+    copy_wide(&inputs[3], &x_inverse);
+    for (int i = 0; i < 4; ++i) {
+      invert_wide_fermat(&fermat, &inputs[i]);
+      invert_wide(&result, &inputs[i]);
+      assert(equal_wide(&result, &fermat));
+      invert_wide_var(&result, &inputs[i]);
+      assert(equal_wide(&result, &fermat));
+    }
+  }
+
+  {
+    // Batch inversion agrees with inverting one at a time.
+    residue_wide_t batch_in[4];
+    residue_wide_t batch_out[4];
+    residue_narrow_t batch_in_narrow[4];
+    residue_narrow_t batch_out_narrow[4];
+    residue_wide_t batch_out_widened;
+    copy_wide(&batch_in[0], &x_wide);
+    copy_wide(&batch_in[1], &y_wide);
+    copy_wide(&batch_in[2], &x_plus_two);
+    copy_wide(&batch_in[3], &x_inverse);
+    for (int i = 0; i < 4; ++i) {
+      narrow(&batch_in_narrow[i], &batch_in[i]);
+    }
+    for (size_t n = 1; n <= 4; ++n) {
+      invert_wide_batch(batch_out, batch_in, n);
+      invert_narrow_batch(batch_out_narrow, batch_in_narrow, n);
+      for (size_t i = 0; i < n; ++i) {
+        invert_wide(&result, &batch_in[i]);
+        assert(equal_wide(&result, &batch_out[i]));
+        widen(&batch_out_widened, &batch_out_narrow[i]);
+        assert(equal_wide(&result, &batch_out_widened));
+      }
+    }
+    assert(equal_wide(&batch_out[0], &x_inverse));
+  }
 
 
   reduce_hash_mod_l(&scalar_result, &scalar_hash_val);
@@ -542,8 +699,39 @@ int main(int _argc, char **argv) {
     //assert(computed_base_comb.combs[3].table[7].y.limbs[i] ==
       //expected_gray_code_end3.y.limbs[i]);
   }
+
+  // Whatever the geometry, the generated table has to match.
+  for (int i = 0; i < COMB_COUNT; ++i) {
+    for (int j = 0; j < COMB_TABLE_SIZE; ++j) {
+      residue_narrow_reduced_t computed, expected;
+      narrow_complete(&computed, &computed_base_comb.combs[i].table[j].x);
+      narrow_complete(&expected, &base_comb.combs[i].table[j].x);
+      assert(equal_narrow_reduced(&computed, &expected));
+      narrow_complete(&computed, &computed_base_comb.combs[i].table[j].y);
+      narrow_complete(&expected, &base_comb.combs[i].table[j].y);
+      assert(equal_narrow_reduced(&computed, &expected));
+    }
+  }
   #endif
 
+  // The generated odd multiples of B have to match too.
+  {
+    extended_affine_pt_readd_narrow_t computed[BASE_WNAF_TABLE_SIZE];
+    compute_odd_multiples(computed, &B);
+    for (int i = 0; i < BASE_WNAF_TABLE_SIZE; ++i) {
+      residue_narrow_reduced_t computed_r, expected_r;
+      narrow_complete(&computed_r, &computed[i].x);
+      narrow_complete(&expected_r, &base_odd_multiples[i].x);
+      assert(equal_narrow_reduced(&computed_r, &expected_r));
+      narrow_complete(&computed_r, &computed[i].dt);
+      narrow_complete(&expected_r, &base_odd_multiples[i].dt);
+      assert(equal_narrow_reduced(&computed_r, &expected_r));
+      narrow_complete(&computed_r, &computed[i].y);
+      narrow_complete(&expected_r, &base_odd_multiples[i].y);
+      assert(equal_narrow_reduced(&computed_r, &expected_r));
+    }
+  }
+
   #if 1
   for (int i = 0; i<1; ++i) {
     scalar_comb_multiply(&result_pt, &base_comb, &mult_scalar);
@@ -556,6 +744,37 @@ int main(int _argc, char **argv) {
     assert(equal_wide(&tmp, &result_pt.y));
   }
   #endif
+  {
+    // point_compress matches encode_pub_key of the affine point, and the batch
+    // version matches it for any z, across more than one shared inversion.
+    affine_pt_narrow_t expected_affine;
+    uint8_t expected_bytes[RESIDUE_LENGTH_BYTES];
+    uint8_t compressed[RESIDUE_LENGTH_BYTES];
+    narrow(&expected_affine.x, &expected_scalar_mult.x);
+    narrow(&expected_affine.y, &expected_scalar_mult.y);
+    encode_pub_key(expected_bytes, &expected_affine);
+    point_compress(compressed, &result_pt);
+    assert(memcmp(compressed, expected_bytes, RESIDUE_LENGTH_BYTES) == 0);
+
+    #define COMPRESS_TEST_POINTS (POINT_COMPRESS_BATCH + 3)
+    projective_pt_wide_t scaled_pts[COMPRESS_TEST_POINTS];
+    uint8_t batch_bytes[COMPRESS_TEST_POINTS][RESIDUE_LENGTH_BYTES];
+    copy_projective_pt_wide(&scaled_pts[0], &result_pt);
+    for (int i = 1; i < COMPRESS_TEST_POINTS; ++i) {
+      mul_wide(&scaled_pts[i].x, &scaled_pts[i - 1].x, &result_pt.z);
+      mul_wide(&scaled_pts[i].y, &scaled_pts[i - 1].y, &result_pt.z);
+      mul_wide(&scaled_pts[i].z, &scaled_pts[i - 1].z, &result_pt.z);
+    }
+    for (int n = 0; n <= COMPRESS_TEST_POINTS; n += COMPRESS_TEST_POINTS) {
+      memset(batch_bytes, 0, sizeof(batch_bytes));
+      point_compress_batch(&batch_bytes[0][0], scaled_pts, n);
+      for (int i = 0; i < COMPRESS_TEST_POINTS; ++i) {
+        assert((memcmp(batch_bytes[i], expected_bytes,
+          RESIDUE_LENGTH_BYTES) == 0) == (i < n));
+      }
+    }
+    #undef COMPRESS_TEST_POINTS
+  }
   #if 0
   for (int i = 0; i<1; ++i) {
     scalar_t priv_key;
@@ -600,5 +819,423 @@ int main(int _argc, char **argv) {
       printf("verification failed\n");
       exit(1);
     }
+    {
+      // A signing context signs and verifies like sign and verify, and
+      // signatures from a nonce pool verify, both from the pool and computed
+      // when it is empty. No presignature is handed out twice.
+      signing_ctx_t ctx;
+      signature_t ctx_sig;
+      assert(signing_ctx_init(&ctx, encoded_sk));
+      sign_ctx(&ctx_sig, &ctx, msg, msglen);
+      assert(verify_ctx(&ctx, &ctx_sig, msg, msglen));
+      assert(verify_ctx(&ctx, &result_decoded, msg, msglen));
+      assert(!verify_ctx(&ctx, &ctx_sig, msg, msglen - 1));
+      {
+        // Streaming verification agrees with verify, however the message is split.
+        verify_stream_t stream;
+        for (size_t split = 0; split <= msglen; split += 4) {
+          verify_init(&stream, &ctx_sig, ctx.pub_key);
+          verify_update(&stream, msg, split);
+          verify_update(&stream, msg + split, msglen - split);
+          assert(verify_final(&stream));
+        }
+        verify_init(&stream, &ctx_sig, ctx.pub_key);
+        verify_update(&stream, msg, msglen - 1);
+        assert(!verify_final(&stream));
+        uint8_t bad_pub_key[RESIDUE_LENGTH_BYTES];
+        memset(bad_pub_key, 0xff, sizeof(bad_pub_key));
+        verify_init(&stream, &ctx_sig, bad_pub_key);
+        verify_update(&stream, msg, msglen);
+        assert(!verify_final(&stream));
+      }
+      {
+        // Prehash mode: the message can be fed in pieces, and signatures only
+        // verify in the mode they were made in.
+        sign_prehash_t prehash;
+        signature_t prehash_sig;
+        signature_t digest_sig;
+        uint8_t digest[PREHASH_BYTES];
+        uint8_t prehash_r[RESIDUE_LENGTH_BYTES];
+        uint8_t digest_r[RESIDUE_LENGTH_BYTES];
+        sign_prehash_init(&prehash);
+        sign_prehash_update(&prehash, msg, 5);
+        sign_prehash_update(&prehash, msg + 5, 0);
+        sign_prehash_update(&prehash, msg + 5, msglen - 5);
+        sign_prehash_final(&prehash_sig, &prehash, &ctx);
+        sign_prehash_init(&prehash);
+        sign_prehash_update(&prehash, msg, msglen);
+        sign_prehash_digest(digest, &prehash);
+        encode(prehash_r, &prehash_sig.y);
+        assert(verify_prehashed(&prehash_sig, prehash_r, ctx.pub_key,
+                                &ctx.pub_key_pt, digest));
+        assert(!verify_ctx(&ctx, &prehash_sig, digest, PREHASH_BYTES));
+        sign_ctx(&digest_sig, &ctx, digest, PREHASH_BYTES);
+        encode(digest_r, &digest_sig.y);
+        assert(!verify_prehashed(&digest_sig, digest_r, ctx.pub_key,
+                                 &ctx.pub_key_pt, digest));
+        digest[0] ^= 1;
+        assert(!verify_prehashed(&prehash_sig, prehash_r, ctx.pub_key,
+                                 &ctx.pub_key_pt, digest));
+      }
+
+      nonce_pool_t pool;
+      uint8_t pooled_r[6][RESIDUE_LENGTH_BYTES];
+      assert(nonce_pool_init(&pool, &ctx, 2));
+      for (int i = 0; i < 6; ++i) {
+        signature_t pooled_sig;
+        sign_pooled(&pooled_sig, &pool, msg, msglen);
+        encode(pooled_r[i], &pooled_sig.y);
+        assert(verify_ctx(&ctx, &pooled_sig, msg, msglen));
+        for (int j = 0; j < i; ++j) {
+          assert(memcmp(pooled_r[i], pooled_r[j], RESIDUE_LENGTH_BYTES) != 0);
+        }
+      }
+
+      // A child after fork wipes the presignatures it inherited, so parent
+      // and child never sign with the same session key. Fill the pool first
+      // so that there is something to inherit.
+      for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        int pool_full = pool.count == pool.capacity;
+        pthread_mutex_unlock(&pool.lock);
+        if (pool_full) {
+          break;
+        }
+        sched_yield();
+      }
+      int fork_pipe[2];
+      assert(pipe(fork_pipe) == 0);
+      pid_t child = fork();
+      assert(child >= 0);
+      if (child == 0) {
+        presignature_t child_presig;
+        nonce_pool_take(&pool, &child_presig);
+        ssize_t written =
+          write(fork_pipe[1], child_presig.r_bytes, RESIDUE_LENGTH_BYTES);
+        nonce_pool_destroy(&pool);
+        _exit(written == RESIDUE_LENGTH_BYTES ? 0 : 1);
+      }
+      presignature_t parent_presig;
+      uint8_t child_r[RESIDUE_LENGTH_BYTES];
+      int child_status;
+      nonce_pool_take(&pool, &parent_presig);
+      assert(read(fork_pipe[0], child_r, RESIDUE_LENGTH_BYTES) ==
+             RESIDUE_LENGTH_BYTES);
+      assert(memcmp(child_r, parent_presig.r_bytes, RESIDUE_LENGTH_BYTES)
+             != 0);
+      assert(waitpid(child, &child_status, 0) == child);
+      assert(WIFEXITED(child_status) && WEXITSTATUS(child_status) == 0);
+      close(fork_pipe[0]);
+      close(fork_pipe[1]);
+
+      nonce_pool_destroy(&pool);
+      signing_ctx_destroy(&ctx);
+    }
   }
+  #if 1
+  {
+    // Multi-scalar multiplication agrees with a sum of single multiplies.
+    affine_pt_narrow_t msm_points[33];
+    scalar_t msm_scalars[33];
+    projective_pt_wide_t msm_expected;
+    projective_pt_wide_t msm_result;
+    projective_pt_wide_t msm_term;
+    projective_pt_wide_t msm_temp;
+    residue_wide_t lhs, rhs;
+    for (int i = 0; i < 33; ++i) {
+      gen_key(&msm_scalars[i], &msm_points[i]);
+    }
+    assert(multi_scalar_multiply_unsafe(&msm_result, msm_points, msm_scalars,
+                                        0));
+    assert(equal_wide(&msm_result.x, &zero_wide));
+    assert(equal_wide(&msm_result.y, &msm_result.z));
+
+    scalar_multiply_unsafe(&msm_expected, &msm_points[0], &msm_scalars[0]);
+    for (int i = 1; i <= 33; ++i) {
+      assert(multi_scalar_multiply_unsafe(&msm_result, msm_points,
+                                          msm_scalars, i));
+      mul_wide(&lhs, &msm_result.x, &msm_expected.z);
+      mul_wide(&rhs, &msm_expected.x, &msm_result.z);
+      assert(equal_wide(&lhs, &rhs));
+      mul_wide(&lhs, &msm_result.y, &msm_expected.z);
+      mul_wide(&rhs, &msm_expected.y, &msm_result.z);
+      assert(equal_wide(&lhs, &rhs));
+      if (i < 33) {
+        scalar_multiply_unsafe(&msm_term, &msm_points[i], &msm_scalars[i]);
+        projective_add(&msm_temp, &msm_expected, &msm_term);
+        copy_projective_pt_wide(&msm_expected, &msm_temp);
+      }
+    }
+
+    // Partially reduced scalars use bit SCALAR_BITS, and signed digits carry
+    // one past it. 512 points get 7 bit windows, and 7 divides
+    // SCALAR_BITS + 1, so the carry needs a window of its own.
+    static affine_pt_narrow_t wide_points[512];
+    static scalar_t wide_scalars[512];
+    scalar_t wide_scalar = {
+      .limbs = {
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7,
+      },
+    };
+    for (int i = 0; i < 512; ++i) {
+      wide_points[i] = msm_points[0];
+      memset(&wide_scalars[i], 0, sizeof(scalar_t));
+    }
+    wide_scalars[0] = wide_scalar;
+    scalar_multiply(&msm_expected, &msm_points[0], &wide_scalar);
+    assert(multi_scalar_multiply_unsafe(&msm_result, wide_points,
+                                        wide_scalars, 512));
+    mul_wide(&lhs, &msm_result.x, &msm_expected.z);
+    mul_wide(&rhs, &msm_expected.x, &msm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+    mul_wide(&lhs, &msm_result.y, &msm_expected.z);
+    mul_wide(&rhs, &msm_expected.y, &msm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+  }
+  #endif
+  #if 1
+  {
+    // Joint s * B + h * A agrees with separate multiplies.
+    scalar_t dsm_s, dsm_h;
+    affine_pt_narrow_t dsm_pt, dsm_unused;
+    projective_pt_wide_t dsm_sB, dsm_hA, dsm_expected, dsm_result;
+    residue_wide_t lhs, rhs;
+    gen_key(&dsm_s, &dsm_unused);
+    gen_key(&dsm_h, &dsm_pt);
+    scalar_comb_multiply_unsafe(&dsm_sB, &base_comb, &dsm_s);
+    scalar_multiply_unsafe(&dsm_hA, &dsm_pt, &dsm_h);
+    projective_add(&dsm_expected, &dsm_sB, &dsm_hA);
+    double_scalar_multiply_unsafe(&dsm_result, &dsm_s, &dsm_pt, &dsm_h);
+    mul_wide(&lhs, &dsm_result.x, &dsm_expected.z);
+    mul_wide(&rhs, &dsm_expected.x, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+    mul_wide(&lhs, &dsm_result.y, &dsm_expected.z);
+    mul_wide(&rhs, &dsm_expected.y, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+
+    // Partially reduced scalars use bit SCALAR_BITS, and their wNAF carries
+    // one digit past it.
+    scalar_t wide_scalar = {
+      .limbs = {
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7,
+      },
+    };
+    scalar_multiply(&dsm_expected, &dsm_pt, &wide_scalar);
+    scalar_multiply_unsafe(&dsm_result, &dsm_pt, &wide_scalar);
+    mul_wide(&lhs, &dsm_result.x, &dsm_expected.z);
+    mul_wide(&rhs, &dsm_expected.x, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+    mul_wide(&lhs, &dsm_result.y, &dsm_expected.z);
+    mul_wide(&rhs, &dsm_expected.y, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+
+    scalar_t zero_scalar = {0};
+    double_scalar_multiply_unsafe(&dsm_result, &zero_scalar, &dsm_pt,
+                                  &dsm_h);
+    mul_wide(&lhs, &dsm_result.x, &dsm_hA.z);
+    mul_wide(&rhs, &dsm_hA.x, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+    double_scalar_multiply_unsafe(&dsm_result, &zero_scalar, &dsm_pt,
+                                  &zero_scalar);
+    assert(equal_wide(&dsm_result.x, &zero_wide));
+    assert(equal_wide(&dsm_result.y, &dsm_result.z));
+
+    // Partially reduced hashes use bit SCALAR_BITS, and their wNAF carries
+    // one digit past it.
+    scalar_t wide_dsm_scalar = {
+      .limbs = {
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+        0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7,
+      },
+    };
+    scalar_multiply(&dsm_hA, &dsm_pt, &wide_dsm_scalar);
+    double_scalar_multiply_unsafe(&dsm_result, &zero_scalar, &dsm_pt,
+                                  &wide_dsm_scalar);
+    mul_wide(&lhs, &dsm_result.x, &dsm_hA.z);
+    mul_wide(&rhs, &dsm_hA.x, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+    mul_wide(&lhs, &dsm_result.y, &dsm_hA.z);
+    mul_wide(&rhs, &dsm_hA.y, &dsm_result.z);
+    assert(equal_wide(&lhs, &rhs));
+  }
+  #endif
+  #if 1
+  {
+    // Keys are cached after KEY_CACHE_DEFAULT_ADMIT_HITS lookups, and cached
+    // combs verify the same as the plain path.
+    key_cache_t cache;
+    scalar_t cache_priv[3];
+    affine_pt_narrow_t cache_pub[3];
+    uint8_t cache_pub_bytes[3][RESIDUE_LENGTH_BYTES];
+    signature_t cache_sigs[3];
+    uint8_t cache_r[3][RESIDUE_LENGTH_BYTES];
+    const uint8_t *cache_msg = (const uint8_t *) "cached";
+    assert(key_cache_init(&cache, 2, KEY_CACHE_DEFAULT_ADMIT_HITS));
+    for (int i = 0; i < 3; ++i) {
+      gen_key(&cache_priv[i], &cache_pub[i]);
+      encode_pub_key(cache_pub_bytes[i], &cache_pub[i]);
+      sign(&cache_sigs[i], &cache_priv[i], cache_pub_bytes[i], cache_msg, 6);
+      encode(cache_r[i], &cache_sigs[i].y);
+    }
+
+    assert(key_cache_lookup(&cache, cache_pub_bytes[0]) == NULL);
+    const key_cache_entry_t *entry =
+      key_cache_lookup(&cache, cache_pub_bytes[0]);
+    assert(entry != NULL);
+    assert(key_cache_lookup(&cache, cache_pub_bytes[0]) == entry);
+    assert(verify_with_comb(&cache_sigs[0], cache_r[0], cache_pub_bytes[0],
+                            &entry->comb, cache_msg, 6));
+    assert(!verify_with_comb(&cache_sigs[0], cache_r[0], cache_pub_bytes[0],
+                             &entry->comb, cache_msg, 5));
+    // Flipping the x parity keeps y matching, but must still fail.
+    cache_sigs[0].y.limbs[NLIMBS_REDUCED - 1] ^= 1 << TBITS;
+    assert(!verify_with_comb(&cache_sigs[0], cache_r[0], cache_pub_bytes[0],
+                             &entry->comb, cache_msg, 6));
+    assert(!verify(&cache_sigs[0], cache_r[0], cache_pub_bytes[0],
+                   &cache_pub[0], cache_msg, 6));
+    cache_sigs[0].y.limbs[NLIMBS_REDUCED - 1] ^= 1 << TBITS;
+
+    // Cycle more keys than fit through the cache.
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < 3; ++i) {
+        assert(verify_cached(&cache, &cache_sigs[i], cache_r[i],
+                             cache_pub_bytes[i], cache_msg, 6));
+        assert(!verify_cached(&cache, &cache_sigs[i], cache_r[(i + 1) % 3],
+                              cache_pub_bytes[i], cache_msg, 6));
+      }
+    }
+    key_cache_destroy(&cache);
+
+    // admit_hits beyond what the lookup counts can hold is clamped, rather
+    // than never admitting anything.
+    assert(key_cache_init(&cache, 2, 1000));
+    for (int i = 1; i < KEY_CACHE_MAX_ADMIT_HITS; ++i) {
+      assert(key_cache_lookup(&cache, cache_pub_bytes[0]) == NULL);
+    }
+    assert(key_cache_lookup(&cache, cache_pub_bytes[0]) != NULL);
+    key_cache_destroy(&cache);
+  }
+  #endif
+  #if 1
+  {
+    scalar_t batch_priv[3];
+    affine_pt_narrow_t batch_pub[3];
+    uint8_t batch_pub_bytes[3][RESIDUE_LENGTH_BYTES];
+    for (int i = 0; i < 3; ++i) {
+      gen_key(&batch_priv[i], &batch_pub[i]);
+      encode_pub_key(batch_pub_bytes[i], &batch_pub[i]);
+    }
+
+    const char *batch_msgs[6] = {
+      "Hello World!", "", "batch", "verification", "of six", "signatures",
+    };
+    signature_t sigs[6];
+    uint8_t r_bufs[6][RESIDUE_LENGTH_BYTES];
+    const uint8_t *r_ptrs[6];
+    const uint8_t *pub_ptrs[6];
+    const affine_pt_narrow_t *pub_pt_ptrs[6];
+    const uint8_t *msg_ptrs[6];
+    size_t msg_lens[6];
+    int valid[6];
+    for (int i = 0; i < 6; ++i) {
+      msg_ptrs[i] = (const uint8_t *) batch_msgs[i];
+      msg_lens[i] = strlen(batch_msgs[i]);
+      pub_ptrs[i] = batch_pub_bytes[i % 3];
+      pub_pt_ptrs[i] = &batch_pub[i % 3];
+      sign(&sigs[i], &batch_priv[i % 3], pub_ptrs[i], msg_ptrs[i],
+           msg_lens[i]);
+      encode(r_bufs[i], &sigs[i].y);
+      r_ptrs[i] = r_bufs[i];
+    }
+
+    assert(verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                        msg_lens, 6, valid));
+    for (int i = 0; i < 6; ++i) {
+      assert(valid[i]);
+    }
+    assert(verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                        msg_lens, 0, NULL));
+
+    // A single bad signature fails the batch and is identified.
+    sigs[4].s.limbs[0] ^= 1;
+    assert(!verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                         msg_lens, 6, valid));
+    for (int i = 0; i < 6; ++i) {
+      assert(valid[i] == (i != 4));
+    }
+    sigs[4].s.limbs[0] ^= 1;
+
+    // As does a signature checked against the wrong key.
+    pub_ptrs[1] = batch_pub_bytes[2];
+    pub_pt_ptrs[1] = &batch_pub[2];
+    assert(!verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                         msg_lens, 6, valid));
+    for (int i = 0; i < 6; ++i) {
+      assert(valid[i] == (i != 1));
+    }
+    pub_ptrs[1] = batch_pub_bytes[1];
+    pub_pt_ptrs[1] = &batch_pub[1];
+
+    // Signatures whose R has a small order component. sB + hA is the honest
+    // R = (x, y), but the signature carries R + T for T = (1, 0), (0, -1) or
+    // (-1, 0), which is (y, -x), (-x, -y) or (-y, x). verify and verify_batch
+    // are both cofactored, so both accept them.
+    uint8_t torsion_sk[SCALAR_BYTES + RESIDUE_LENGTH_BYTES];
+    memcpy(torsion_sk, &batch_priv[2], SCALAR_BYTES);
+    memcpy(torsion_sk + SCALAR_BYTES, batch_pub_bytes[2],
+           RESIDUE_LENGTH_BYTES);
+    signing_ctx_t torsion_ctx;
+    assert(signing_ctx_init(&torsion_ctx, torsion_sk));
+    for (int t = 1; t < 4; ++t) {
+      presignature_t torsion_presig;
+      presign(&torsion_presig, &torsion_ctx);
+      residue_narrow_reduced_t torsion_r_y;
+      affine_pt_narrow_t torsion_r_pt;
+      decode(&torsion_r_y, torsion_presig.r_bytes);
+      int torsion_x_is_odd = torsion_r_y.limbs[NLIMBS_REDUCED - 1] >> TBITS;
+      torsion_r_y.limbs[NLIMBS_REDUCED - 1] &= TMASK;
+      assert(point_decompress(&torsion_r_pt, &torsion_r_y, torsion_x_is_odd));
+
+      residue_narrow_t torsion_x, torsion_y;
+      residue_narrow_reduced_t torsion_x_reduced, torsion_y_reduced;
+      if (t == 1) {
+        copy_narrow(&torsion_x, &torsion_r_pt.y);
+        negate_narrow(&torsion_y, &torsion_r_pt.x);
+      } else if (t == 2) {
+        negate_narrow(&torsion_x, &torsion_r_pt.x);
+        negate_narrow(&torsion_y, &torsion_r_pt.y);
+      } else {
+        negate_narrow(&torsion_x, &torsion_r_pt.y);
+        copy_narrow(&torsion_y, &torsion_r_pt.x);
+      }
+      narrow_complete(&torsion_x_reduced, &torsion_x);
+      narrow_complete(&torsion_y_reduced, &torsion_y);
+      torsion_y_reduced.limbs[NLIMBS_REDUCED - 1] |=
+        is_odd(&torsion_x_reduced) << TBITS;
+      encode(torsion_presig.r_bytes, &torsion_y_reduced);
+
+      sign_presigned(&sigs[5], &torsion_presig, &torsion_ctx, msg_ptrs[5],
+                     msg_lens[5]);
+      memcpy(r_bufs[5], torsion_presig.r_bytes, RESIDUE_LENGTH_BYTES);
+      assert(verify(&sigs[5], r_ptrs[5], pub_ptrs[5], pub_pt_ptrs[5],
+                    msg_ptrs[5], msg_lens[5]));
+      assert(verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                          msg_lens, 6, valid));
+      for (int i = 0; i < 6; ++i) {
+        assert(valid[i]);
+      }
+
+      // Flipping the parity of x breaks the signature for both.
+      sigs[5].y.limbs[NLIMBS_REDUCED - 1] ^= 1 << TBITS;
+      assert(!verify(&sigs[5], r_ptrs[5], pub_ptrs[5], pub_pt_ptrs[5],
+                     msg_ptrs[5], msg_lens[5]));
+      assert(!verify_batch(sigs, r_ptrs, pub_ptrs, pub_pt_ptrs, msg_ptrs,
+                           msg_lens, 6, valid));
+      assert(!valid[5]);
+    }
+    signing_ctx_destroy(&torsion_ctx);
+  }
+  #endif
 }
@@ -0,0 +1,61 @@
+// Generates include/base_wnaf.c: the odd multiples of the base point used by
+// the BASE_WNAF_BITS wNAF in double_scalar_multiply_unsafe. Build with
+// BASE_WNAF_NO_TABLE so that the stale table isn't compiled in. See the
+// base_wnaf target in the Makefile.
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "curve.h"
+
+#include "f11_260.c"
+#include "curve.c"
+#include "scalar.c"
+#include "constant_time.c"
+
+static void print_residue(const char *name, const residue_narrow_t *x) {
+  residue_narrow_reduced_t reduced;
+  narrow_complete(&reduced, x);
+
+  // The avx2 layout duplicates the top limb (always 0 here) in limb 0.
+  printf("    .%s = {\n", name);
+  printf("      .limbs = {\n");
+  printf("        0, ");
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    printf("%#x,", reduced.limbs[i]);
+    if (i == 4) {
+      printf("\n        ");
+    } else {
+      printf(" ");
+    }
+  }
+  printf("0,\n");
+  printf("      },\n");
+  printf("    },\n");
+}
+
+int main(void) {
+  extended_affine_pt_readd_narrow_t table[BASE_WNAF_TABLE_SIZE];
+  compute_odd_multiples(table, &B);
+
+  printf("// Generated by tools/gen_base_wnaf.c. Do not edit; run make base_wnaf.\n");
+  printf("#if BASE_WNAF_BITS != %d\n", BASE_WNAF_BITS);
+  printf("#error \"base_wnaf.c doesn't match BASE_WNAF_BITS. "
+         "Run make base_wnaf.\"\n");
+  printf("#endif\n\n");
+
+  printf("// Odd multiples B, 3B, ... of the base point, for wNAF multiplication.\n");
+  printf("__attribute__((__aligned__(32)))\n");
+  printf("const extended_affine_pt_readd_narrow_t\n");
+  printf("base_odd_multiples[BASE_WNAF_TABLE_SIZE] = {\n");
+  for (int i = 0; i < BASE_WNAF_TABLE_SIZE; ++i) {
+    printf("  {\n");
+    print_residue("x", &table[i].x);
+    print_residue("dt", &table[i].dt);
+    print_residue("y", &table[i].y);
+    printf("  },\n");
+  }
+  printf("};\n");
+  return 0;
+}
@@ -0,0 +1 @@
+../../ref/include/base_comb.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/base_wnaf.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/carry_mask.h
\ No newline at end of file
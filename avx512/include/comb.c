@@ -0,0 +1 @@
+../../ref/include/comb.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/comb.h
\ No newline at end of file
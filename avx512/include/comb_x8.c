@@ -0,0 +1,166 @@
+#include <string.h>
+#include "comb.h"
+#include "comb_x8.h"
+#include "curve.h"
+#include "f11_260_x8.h"
+#include "scalar.h"
+#include "immintrin.h"
+
+// Broadcast each limb of a table residue into the lanes of accum selected by
+// mask.
+static inline void masked_load_x8(
+  residue_x8_t *accum, __mmask8 mask, const residue_narrow_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    __m512i limbs = _mm512_load_si512((__m512i*) accum->limbs[i]);
+    limbs = _mm512_mask_mov_epi64(
+      limbs, mask, _mm512_set1_epi64(x->limbs[i]));
+    _mm512_store_si512((__m512i*) accum->limbs[i], limbs);
+  }
+}
+
+void constant_time_extended_affine_lookup_x8(
+  extended_affine_pt_readd_x8_t *result, __m512i entries, int n,
+  const extended_affine_pt_readd_narrow_t *table) {
+
+  memset(result, 0, sizeof(*result));
+  for (int k = 0; k < n; ++k) {
+    __mmask8 mask = _mm512_cmpeq_epi64_mask(entries, _mm512_set1_epi64(k));
+    masked_load_x8(&result->x, mask, &table[k].x);
+    masked_load_x8(&result->dt, mask, &table[k].dt);
+    masked_load_x8(&result->y, mask, &table[k].y);
+  }
+}
+
+void affine_readd_to_extended_x8(
+  extended_pt_x8_t *result, const extended_affine_pt_readd_x8_t *x) {
+
+  copy_x8(&result->x, &x->x);
+  copy_x8(&result->y, &x->y);
+  mul_x8(&result->t, &x->x, &x->y);
+  one_x8(&result->z);
+}
+
+// Same formulas as extended_double_extended.
+void extended_double_extended_x8(
+  extended_pt_x8_t *result, const extended_pt_x8_t *x) {
+
+  residue_x8_t x_plus_y;
+  residue_x8_t a, b, c, c_temp, e, f, g, h;
+  add_x8(&x_plus_y, &x->x, &x->y);
+  square_x8(&a, &x->x);
+  square_x8(&b, &x->y);
+  square_x8(&c_temp, &x->z);
+  double_x8(&c, &c_temp);
+
+  square_x8(&e, &x_plus_y);
+  sub_x8(&e, &e, &a);
+  sub_x8(&e, &e, &b);
+  add_x8(&g, &a, &b);
+  sub_x8(&f, &g, &c);
+  sub_x8(&h, &a, &b);
+
+  mul_x8(&result->x, &e, &f);
+  mul_x8(&result->z, &f, &g);
+  mul_x8(&result->y, &g, &h);
+  mul_x8(&result->t, &e, &h);
+}
+
+// Same formulas as extended_readd_affine_narrow_extended.
+void extended_readd_affine_x8_extended(
+  extended_pt_x8_t *result, const extended_pt_x8_t *x1,
+  const extended_affine_pt_readd_x8_t *x2) {
+
+  residue_x8_t x1_plus_y1;
+  residue_x8_t x2_plus_y2;
+  residue_x8_t a, b, c, e, f, g, h;
+
+  mul_x8(&a, &x1->x, &x2->x);
+  mul_x8(&b, &x1->y, &x2->y);
+  mul_x8(&c, &x1->t, &x2->dt);
+
+  add_x8(&x1_plus_y1, &x1->x, &x1->y);
+  add_x8(&x2_plus_y2, &x2->x, &x2->y);
+  mul_x8(&e, &x1_plus_y1, &x2_plus_y2);
+  sub_x8(&e, &e, &a);
+  sub_x8(&e, &e, &b);
+  sub_x8(&f, &x1->z, &c);
+  add_x8(&g, &x1->z, &c);
+  sub_x8(&h, &b, &a);
+
+  mul_x8(&result->x, &e, &f);
+  mul_x8(&result->z, &f, &g);
+  mul_x8(&result->y, &g, &h);
+  mul_x8(&result->t, &e, &h);
+}
+
+// The schedule of scalar_comb_multiply, with lane j working on n[j].
+void scalar_comb_multiply_x8(
+  projective_pt_narrow_t *result, const sabs_comb_set_t * __restrict comb,
+  const scalar_t * __restrict n) {
+
+  scalar_t sabs_n[LANES_X8];
+  for (int l = 0; l < LANES_X8; ++l) {
+    convert_to_comb_sabs(&sabs_n[l], &n[l]);
+  }
+
+  extended_pt_x8_t temp;
+  extended_affine_pt_readd_x8_t table_pt;
+  __attribute__((__aligned__(64)))
+  int64_t entries[LANES_X8];
+
+  for (int i = COMB_SEPARATION - 1; i >= 0; --i) {
+    if (i != COMB_SEPARATION - 1) {
+      extended_double_extended_x8(&temp, &temp);
+    }
+    for (int j = 0; j < COMB_COUNT; ++j) {
+      __mmask8 invert_mask = 0;
+      for (int l = 0; l < LANES_X8; ++l) {
+        int entry = 0;
+        for (int k = 0; k < COMB_TEETH; ++k) {
+          int bit = i + COMB_SEPARATION * (k + COMB_TEETH * j);
+          if (bit < SCALAR_BITS) {
+            entry |= ((sabs_n[l].limbs[bit / SCALAR_LIMB_BITS] >>
+                (bit % SCALAR_LIMB_BITS)) & 1) << k;
+          }
+        }
+
+        // The highest bit is the sign bit.
+        int32_t invert = (entry >> (COMB_TEETH - 1)) - 1;
+        entry ^= invert;
+        entries[l] = entry & COMB_LOOKUP_MASK;
+        invert_mask |= (invert & 1) << l;
+      }
+
+      constant_time_extended_affine_lookup_x8(
+        &table_pt, _mm512_load_si512((__m512i*) entries), COMB_TABLE_SIZE,
+        comb->combs[j].table);
+      cond_negate_x8(&table_pt.x, &table_pt.x, invert_mask);
+      cond_negate_x8(&table_pt.dt, &table_pt.dt, invert_mask);
+
+      if (i == (COMB_SEPARATION - 1) && j == 0) {
+        affine_readd_to_extended_x8(&temp, &table_pt);
+      } else {
+        extended_readd_affine_x8_extended(&temp, &temp, &table_pt);
+      }
+    }
+  }
+
+  residue_narrow_t coordinates[LANES_X8];
+  unpack_x8(coordinates, &temp.x);
+  for (int l = 0; l < LANES_X8; ++l) {
+    copy_narrow(&result[l].x, &coordinates[l]);
+  }
+  unpack_x8(coordinates, &temp.y);
+  for (int l = 0; l < LANES_X8; ++l) {
+    copy_narrow(&result[l].y, &coordinates[l]);
+  }
+  unpack_x8(coordinates, &temp.z);
+  for (int l = 0; l < LANES_X8; ++l) {
+    copy_narrow(&result[l].z, &coordinates[l]);
+  }
+  explicit_bzero(sabs_n, sizeof(sabs_n));
+  explicit_bzero(entries, sizeof(entries));
+  explicit_bzero(&table_pt, sizeof(table_pt));
+  explicit_bzero(&temp, sizeof(temp));
+  explicit_bzero(coordinates, sizeof(coordinates));
+}
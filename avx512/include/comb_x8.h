@@ -0,0 +1,48 @@
+// Eight comb multiplications in lockstep, one per 64-bit lane. Every lane takes
+// the same sequence of doublings and additions, so the only lane dependent
+// work is the table lookup, which scans the whole table.
+
+#ifndef COMB_X8_H
+#define COMB_X8_H
+#include "comb.h"
+#include "curve.h"
+#include "f11_260_x8.h"
+#include "scalar.h"
+
+// Eight extended points.
+typedef struct extended_pt_x8 {
+  residue_x8_t x;
+  residue_x8_t y;
+  residue_x8_t t;
+  residue_x8_t z;
+} extended_pt_x8_t;
+
+// Eight affine points, with dt = d * x * y, as stored in a comb table.
+typedef struct extended_affine_pt_readd_x8 {
+  residue_x8_t x;
+  residue_x8_t dt;
+  residue_x8_t y;
+} extended_affine_pt_readd_x8_t;
+
+// Lane j of result gets table[entries[j]]. Every entry of the table is read for
+// every lane, so the access pattern does not depend on entries.
+void constant_time_extended_affine_lookup_x8(
+  extended_affine_pt_readd_x8_t *result, __m512i entries, int n,
+  const extended_affine_pt_readd_narrow_t *table);
+
+void affine_readd_to_extended_x8(
+  extended_pt_x8_t *result, const extended_affine_pt_readd_x8_t *x);
+
+void extended_double_extended_x8(
+  extended_pt_x8_t *result, const extended_pt_x8_t *x);
+
+void extended_readd_affine_x8_extended(
+  extended_pt_x8_t *result, const extended_pt_x8_t *x1,
+  const extended_affine_pt_readd_x8_t *x2);
+
+// Constant time multiplication of eight scalars times the point with comb set
+// comb. Computes result[j] = n[j] * P for j = 0 .. 7.
+void scalar_comb_multiply_x8(
+  projective_pt_narrow_t *result, const sabs_comb_set_t * __restrict comb,
+  const scalar_t * __restrict n);
+#endif
@@ -0,0 +1,84 @@
+#include <stdint.h>
+#include "f11_260.h"
+#include "curve.h"
+
+#include "immintrin.h"
+
+// Each narrow residue is exactly one 512-bit register. The lookups compare the
+// index against every table entry and do a masked move of the match, so every
+// entry is loaded regardless of i.
+
+void constant_time_extended_narrow_lookup(
+  extended_pt_readd_narrow_t *result, int i, int n,
+  const extended_pt_readd_narrow_t *table) {
+
+  __m512i accum[4];
+  __m512i big_i = _mm512_set1_epi32(i);
+  #pragma clang loop unroll(full)
+  for (int k = 0; k < 4; ++k) {
+    accum[k] = _mm512_setzero_si512();
+  }
+  for (int j = 0; j < n; ++j) {
+    __mmask16 mask = _mm512_cmpeq_epi32_mask(big_i, _mm512_set1_epi32(j));
+    #pragma clang loop unroll(full)
+    for (int k = 0; k < 4; ++k) {
+      __m512i temp = _mm512_load_si512(((__m512i*) &table[j]) + k);
+      accum[k] = _mm512_mask_mov_epi32(accum[k], mask, temp);
+    }
+  }
+  #pragma clang loop unroll(full)
+  for (int k = 0; k < 4; ++k) {
+    _mm512_store_si512(((__m512i*) result) + k, accum[k]);
+  }
+}
+
+void constant_time_extended_affine_narrow_lookup(
+  extended_affine_pt_readd_narrow_t *result, int i, int n,
+  const extended_affine_pt_readd_narrow_t *table) {
+
+  __m512i accum[3];
+  __m512i big_i = _mm512_set1_epi32(i);
+  #pragma clang loop unroll(full)
+  for (int k = 0; k < 3; ++k) {
+    accum[k] = _mm512_setzero_si512();
+  }
+  for (int j = 0; j < n; ++j) {
+    __mmask16 mask = _mm512_cmpeq_epi32_mask(big_i, _mm512_set1_epi32(j));
+    #pragma clang loop unroll(full)
+    for (int k = 0; k < 3; ++k) {
+      __m512i temp = _mm512_load_si512(((__m512i*) &table[j]) + k);
+      accum[k] = _mm512_mask_mov_epi32(accum[k], mask, temp);
+    }
+  }
+  #pragma clang loop unroll(full)
+  for (int k = 0; k < 3; ++k) {
+    _mm512_store_si512(((__m512i*) result) + k, accum[k]);
+  }
+}
+
+// Negate x and dt where mask is all ones.
+void constant_time_cond_extended_negate(
+  extended_pt_readd_narrow_t *x, int32_t mask32) {
+  __m512i zero = _mm512_setzero_si512();
+  __mmask16 mask = _mm512_cmpneq_epi32_mask(_mm512_set1_epi32(mask32), zero);
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < 2; ++i) {
+    __m512i temp = _mm512_load_si512(((__m512i*) x) + i);
+    temp = _mm512_mask_sub_epi32(temp, mask, zero, temp);
+    _mm512_store_si512(((__m512i*) x) + i, temp);
+  }
+}
+
+void constant_time_cond_extended_affine_negate(
+  extended_affine_pt_readd_narrow_t *x, int32_t mask32) {
+  __m512i zero = _mm512_setzero_si512();
+  __mmask16 mask = _mm512_cmpneq_epi32_mask(_mm512_set1_epi32(mask32), zero);
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < 2; ++i) {
+    __m512i temp = _mm512_load_si512(((__m512i*) x) + i);
+    temp = _mm512_mask_sub_epi32(temp, mask, zero, temp);
+    _mm512_store_si512(((__m512i*) x) + i, temp);
+  }
+}
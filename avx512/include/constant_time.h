@@ -0,0 +1 @@
+../../ref/include/constant_time.h
\ No newline at end of file
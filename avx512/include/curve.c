@@ -0,0 +1 @@
+../../ref/include/curve.c
\ No newline at end of file
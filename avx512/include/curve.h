@@ -0,0 +1 @@
+../../ref/include/curve.h
\ No newline at end of file
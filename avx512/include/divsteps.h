@@ -0,0 +1 @@
+../../ref/include/divsteps.h
\ No newline at end of file
@@ -1,32 +1,40 @@
 #include <stdint.h>
 #include "f11_260.h"
+#include "carry_mask.h"
+#include "divsteps.h"
 #include "mul_inline.h"
-#include "emmintrin.h"
 #include "immintrin.h"
 
+// Shared by all the backends. See divsteps.h
+#include "divsteps.c"
+
 residue_narrow_t zero_narrow = {0};
 residue_narrow_t one_narrow = {
   .limbs = {1},
 };
 
-#define NVECTORS 3
-#define VECTWIDTH 4
+#ifdef FIELD_BOUNDS_CHECK
+#include <assert.h>
+
+void check_bounds_narrow(const residue_narrow_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
 
-__attribute__((__aligned__(32)))
-static const int32_t COLLAPSE[8] = { 0, 2, 4, 6, 4, 5, 6, 7 };
+void check_bounds_wide(const residue_wide_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
+#endif
 
 // Shrink to 32 bits. Assumes reduction has already occurred, and wide storage
 // is being used for vector compatibility.
 void narrow(residue_narrow_t *result, const residue_wide_t * __restrict w) {
-  __m256i collapse_perm = _mm256_load_si256((__m256i*) COLLAPSE);
-  __m128i packed_result;
-  #pragma clang loop unroll(full)
-  for (int i = 0; i < NVECTORS; ++i) {
-    __m256i x = _mm256_load_si256((__m256i*) (&w->limbs[i * VECTWIDTH]));
-    packed_result = _mm256_castsi256_si128(
-        _mm256_permutevar8x32_epi32(x, collapse_perm));
-    _mm_store_si128((__m128i*) &result->limbs[i * VECTWIDTH], packed_result);
-  }
+  __m512i low = _mm512_load_si512((__m512i*) &w->limbs[0]);
+  __m512i high = _mm512_load_si512((__m512i*) &w->limbs[8]);
+  _mm512_store_si512((__m512i*) &result->limbs[0], narrow_vec(low, high));
 }
 
 // Reduce to 10 limbs. Useful for debugging.
@@ -34,114 +42,97 @@ void narrow_reduce(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
   residue_narrow_t temp;
 
-  __m128i x = _mm_load_si128((__m128i *) (&w->limbs[0 * VECTWIDTH]));
-  __m128i x10 = _mm_broadcastd_epi32(x);
-  x = _mm_sub_epi32(x, x10);
-  _mm_store_si128((__m128i *) &temp.limbs[0 * VECTWIDTH], x);
-  x = _mm_load_si128((__m128i *) (&w->limbs[1 * VECTWIDTH]));
-  x = _mm_sub_epi32(x, x10);
-  _mm_store_si128((__m128i *) &temp.limbs[1 * VECTWIDTH], x);
-  x = _mm_load_si128((__m128i *) (&w->limbs[2 * VECTWIDTH]));
-  x = _mm_sub_epi32(x, x10);
-  _mm_store_si128((__m128i *) &temp.limbs[2 * VECTWIDTH], x);
+  __m512i x = _mm512_load_si512((__m512i*) &w->limbs[0]);
+  __m512i x10 = _mm512_set1_epi32(w->limbs[10]);
+  _mm512_store_si512((__m512i*) &temp.limbs[0], _mm512_sub_epi32(x, x10));
 
   reduce_step_narrow(&temp, &temp);
 
-  // May want to use vpalignr here.
-  #pragma clang loop unroll(full)
-  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    result->limbs[i] = temp.limbs[i] - temp.limbs[10];
-  }
+  x = _mm512_load_si512((__m512i*) &temp.limbs[0]);
+  x10 = _mm512_set1_epi32(temp.limbs[10]);
+  _mm512_mask_storeu_epi32(
+    &result->limbs[0], (__mmask16) ((1 << NLIMBS_REDUCED) - 1),
+    _mm512_sub_epi32(x, x10));
+}
+
+// Sets the first 10 lanes of the result to the unique representative of x,
+// as in ref. The three carry steps each take one compare per mask, and the
+// masks are combined in scalar registers, see carry_mask.h
+static inline __m512i complete_vec(__m512i x) {
+  __m512i t = _mm512_set1_epi32(T);
+  __m512i t_minus_1 = _mm512_set1_epi32(T - 1);
+  __m512i one = _mm512_set1_epi32(1);
+
+  // Base t digits of a value congruent to x, in 11 limbs each in [0, t).
+  x = reduce_step_narrow_vec(x);
+  x = _mm512_add_epi32(x, _mm512_set1_epi32(COMPLETE_OFFSET));
+  uint32_t carry = _mm512_mask_cmpge_epi32_mask(LIMB_MASK_NARROW, x, t);
+  uint32_t carry_rot = ((carry << 1) | (carry >> 10)) & DIGITS_MASK;
+  x = _mm512_mask_sub_epi32(x, (__mmask16) carry, x, t);
+  x = _mm512_mask_add_epi32(x, (__mmask16) carry_rot, x, one);
+  uint32_t generate = _mm512_mask_cmpeq_epi32_mask(LIMB_MASK_NARROW, x, t);
+  uint32_t propagate =
+    _mm512_mask_cmpeq_epi32_mask(LIMB_MASK_NARROW, x, t_minus_1);
+  uint32_t carry_in = carry_in_mask_cyclic(generate, propagate);
+  x = _mm512_mask_add_epi32(x, (__mmask16) carry_in, x, one);
+  x = _mm512_mask_sub_epi32(
+    x, (__mmask16) carry_out_mask_cyclic(carry_in), x, t);
+
+  // Subtract digit 10 times p and add p back, leaving a value in (0, 2p).
+  __m512i x10 = _mm512_permutexvar_epi32(_mm512_set1_epi32(10), x);
+  x = _mm512_maskz_add_epi32(
+    REDUCED_DIGITS_MASK, _mm512_sub_epi32(x, x10), t);
+  x = _mm512_mask_add_epi32(x, (__mmask16) 1, x, one);
+  carry = _mm512_mask_cmpge_epi32_mask(REDUCED_DIGITS_MASK, x, t);
+  x = _mm512_mask_sub_epi32(x, (__mmask16) carry, x, t);
+  x = _mm512_mask_add_epi32(x, (__mmask16) (carry << 1), x, one);
+  generate = _mm512_mask_cmpeq_epi32_mask(REDUCED_DIGITS_MASK, x, t);
+  propagate = _mm512_mask_cmpeq_epi32_mask(REDUCED_DIGITS_MASK, x, t_minus_1);
+  carry_in = carry_in_mask(generate, propagate);
+  x = _mm512_mask_add_epi32(x, (__mmask16) carry_in, x, one);
+  x = _mm512_mask_sub_epi32(x, (__mmask16) (carry_in >> 1), x, t);
+
+  // Subtract p, or write the top digits as t.
+  complete_masks_t masks;
+  complete_masks(&masks,
+    _mm512_mask_cmpeq_epi32_mask(LIMB_MASK_NARROW, x, one),
+    _mm512_mask_cmpeq_epi32_mask(
+      LIMB_MASK_NARROW, x, _mm512_setzero_si512()));
+  x = _mm512_mask_sub_epi32(x, (__mmask16) masks.minus_one, x, one);
+  x = _mm512_mask_sub_epi32(x, (__mmask16) masks.borrow_in, x, one);
+  x = _mm512_mask_add_epi32(x, (__mmask16) masks.borrow_out, x, t);
+  return _mm512_mask_mov_epi32(x, (__mmask16) masks.top_t, t);
 }
 
 // Reduce to unique representative.
-// This is expensive. Only used for final signature or DH Key
+// Limbs are in [0, t), except that a value of at least t^10 has its top limbs
+// equal to t. Branch free.
 void narrow_complete(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
-
-  residue_narrow_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[10];
-  }
-
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
-
-  int gt_mask = 0;
-  int lt_mask = 0;
-  int32_t limit[NLIMBS];
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[10];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-  }
-  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] -= temp.limbs[10];
-    limit[i] = T;
-  }
-  int64_t all_t = -1;
-  for (int i = NLIMBS_REDUCED - 2; i >= 0; --i) {
-    all_t &= -(temp.limbs[i+1] == T);
-    limit[i] -= 1 & (~all_t);
-  }
-  gt_mask = 0;
-  lt_mask = 0;
-  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > limit[i]);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i] = temp.limbs[i];
-  }
+  __m512i x = _mm512_load_si512((__m512i*) &w->limbs[0]);
+  _mm512_mask_storeu_epi32(
+    &result->limbs[0], (__mmask16) REDUCED_DIGITS_MASK, complete_vec(x));
 }
 
-// Reduce to mostly unique representative.
-// All coefficients are reduced to 0 <= xi <= t
-// Unique up to carries (xi == t) => (xi = 0; x[i+1] += 1);
-// This is sufficient to determine if x is even or odd.
-// Still pretty expensive. Used in point compression.
+// narrow_complete costs no more, so this is the complete form.
 void narrow_partial_complete(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+  narrow_complete(result, w);
+}
 
-  residue_narrow_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[10];
-  }
-
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
-
-  int gt_mask = 0;
-  int lt_mask = 0;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[10];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-  }
-  for (int i = 0; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] -= temp.limbs[10];
-  }
-  gt_mask = 0;
-  lt_mask = 0;
-  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i] = temp.limbs[i];
-  }
+// The two reductions are independent, so they overlap.
+void narrow_compress(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict x,
+  const residue_narrow_t * __restrict y) {
+  __m512i xv = complete_vec(_mm512_load_si512((__m512i*) &x->limbs[0]));
+  __m512i yv = complete_vec(_mm512_load_si512((__m512i*) &y->limbs[0]));
+  uint32_t odd_limbs = _mm512_mask_test_epi32_mask(
+    REDUCED_DIGITS_MASK, xv, _mm512_set1_epi32(1));
+  int32_t x_is_odd = __builtin_popcount(odd_limbs) & 1;
+  yv = _mm512_mask_or_epi32(yv, (__mmask16) (1 << (NLIMBS_REDUCED - 1)), yv,
+    _mm512_set1_epi32(x_is_odd << TBITS));
+  _mm512_mask_storeu_epi32(
+    &result->limbs[0], (__mmask16) REDUCED_DIGITS_MASK, yv);
 }
 
 int is_odd(residue_narrow_reduced_t *x) {
@@ -171,27 +162,6 @@ void copy_narrow_reduced(
   }
 }
 
-static inline __m256i load_extend_32_64(__m128i *x) {
-  return _mm256_cvtepi32_epi64(_mm_load_si128(x));
-}
-
-static inline __m256i loadu_extend_32_64(__m128i *x) {
-  return _mm256_cvtepi32_epi64(_mm_loadu_si128(x));
-}
-
-static inline __m512i load512_extend_32_64(__m256i *x) {
-  return _mm512_cvtepi32_epi64(_mm256_load_si256(x));
-}
-
-static inline __m512i loadu512_extend_32_64(__m256i *x) {
-  return _mm512_cvtepi32_epi64(_mm256_loadu_si256(x));
-}
-
-static inline __m512i loadu512_mask_extend_32_64(__m256i *x, __mmask8 k) {
-  return _mm512_cvtepi32_epi64(
-    _mm256_mask_loadu_epi32(_mm256_setzero_si256(), k, x));
-}
-
 void reduce_step_narrow(
   residue_narrow_t *result, const residue_narrow_t *x) {
   return reduce_step_narrow_i(result, x);
@@ -216,10 +186,12 @@ void square_narrow(
 // Produce a 64-bit residue
 void widen(
   residue_wide_t *result, const residue_narrow_t * __restrict x) {
-  __m256i wide10 = loadu_extend_32_64((__m128i *) x);
-  __m512i wide3 = loadu512_extend_32_64((__m256i *) &x[4]);
-  _mm256_store_si256((__m256i*) &result->limbs[0], wide10);
-  _mm512_storeu_si512((__m512i*) &result->limbs[4], wide3);
+  __m512i low = _mm512_cvtepi32_epi64(
+    _mm256_load_si256((__m256i*) &x->limbs[0]));
+  __m512i high = _mm512_cvtepi32_epi64(
+    _mm256_load_si256((__m256i*) &x->limbs[8]));
+  _mm512_store_si512((__m512i*) &result->limbs[0], low);
+  _mm512_store_si512((__m512i*) &result->limbs[8], high);
 }
 
 // Subtract 2 12x32-bit residues.
@@ -233,16 +205,16 @@ void sub_narrow(
   _mm512_store_si512((__m512i*) &result->limbs[0], sub);
 }
 
-// negate a 12x64-bit residue.
+// negate an 11x64-bit residue.
 void negate_wide(residue_wide_t *result, const residue_wide_t *x) {
 
-  __m256i zero = _mm256_setzero_si256();
-  #pragma clang loop unroll(full)
-  for (int i = 0; i < NVECTORS; ++i) {
-    __m256i xv = _mm256_load_si256((__m256i*) (&x->limbs[i * VECTWIDTH]));
-    xv = _mm256_sub_epi64(zero, xv);
-    _mm256_store_si256((__m256i*) &result->limbs[i * VECTWIDTH], xv);
-  }
+  __m512i zero = _mm512_setzero_si512();
+  __m512i low = _mm512_load_si512((__m512i*) &x->limbs[0]);
+  __m512i high = _mm512_load_si512((__m512i*) &x->limbs[8]);
+  _mm512_store_si512(
+    (__m512i*) &result->limbs[0], _mm512_sub_epi64(zero, low));
+  _mm512_store_si512(
+    (__m512i*) &result->limbs[8], _mm512_sub_epi64(zero, high));
 }
 
 // negate a 12x32-bit residue.
@@ -250,7 +222,7 @@ void negate_narrow(
   residue_narrow_t *result, const residue_narrow_t *x) {
 
   __m512i lhs = _mm512_load_si512((__m512i*) &x->limbs[0]);
-  __m512i zero = _mm512_setzero();
+  __m512i zero = _mm512_setzero_si512();
   __m512i neg = _mm512_sub_epi32(zero, lhs);
   _mm512_store_si512((__m512i*) &result->limbs[0], neg);
 }
@@ -284,59 +256,19 @@ void double_wide(
   }
 }
 
-#include <stdio.h>
-#include <string.h>
-// static void print4x64(__m256i x, const char * preamble) {
-//   uint64_t x_vals[4];
-//   memcpy(x_vals, &x, sizeof(x_vals));
-//   printf("%s\n", preamble);
-//   for (int i = 0; i < 4; ++i) {
-//     printf("%#lx\n", x_vals[i]);
-//   }
-// }
-
-// static void print8x64(__m512i x, const char * preamble) {
-//   uint64_t x_vals[8];
-//   memcpy(x_vals, &x, sizeof(x_vals));
-//   printf("%s\n", preamble);
-//   for (int i = 0; i < 8; ++i) {
-//     printf("%#lx\n", x_vals[i]);
-//   }
-// }
-
-// static void print16x32(__m512i x, const char * preamble) {
-//   uint32_t x_vals[16];
-//   memcpy(x_vals, &x, sizeof(x_vals));
-//   printf("%s\n", preamble);
-//   for (int i = 0; i < 16; ++i) {
-//     printf("%#x\n", x_vals[i]);
-//   }
-// }
-
-// The swaps below trade 32 bit words within 128 bit lanes
-// in low endian order: 01 00 11 10
-// in big endian order 10 11 00 01 = 0xb1
-
-static const int32_t permute_final_result[16] = {
-  0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
-};
-
 // Multiply a narrow residue by a small constant. The result is reduced to 32
 // bits.
 void mul_narrow_const(
   residue_narrow_t *result, const residue_narrow_t *x, int32_t d) {
 
-  residue_wide_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = ((uint64_t) x->limbs[i]) * d;
-  }
-  reduce_step_wide(&temp, &temp);
-  __m512i _permute_final_result = _mm512_load_si512(permute_final_result);
-  __m512i accum0 = _mm512_load_si512((__m512i*) &temp.limbs[0]);
-  __m256i accum8 = _mm256_load_si256((__m256i*) &temp.limbs[8]);
-  __m512i final_result = _mm512_permutex2var_epi32(
-    accum0, _permute_final_result, _mm512_castsi256_si512(accum8));
-  _mm512_store_si512((__m512i*) &result->limbs[0], final_result);
+  __m512i xv = _mm512_load_si512((__m512i*) &x->limbs[0]);
+  __m512i dv = _mm512_set1_epi64(d);
+  __m512i low = _mm512_mul_epi32(
+    _mm512_cvtepi32_epi64(_mm512_castsi512_si256(xv)), dv);
+  __m512i high = _mm512_mul_epi32(
+    _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(xv, 1)), dv);
+  reduce_step_wide_vec(&low, &high);
+  _mm512_store_si512((__m512i*) &result->limbs[0], narrow_vec(low, high));
 }
 
 // Takes advantage of the fact that if a residue z *is zero* then after setting
@@ -377,11 +309,7 @@ int equal_narrow_reduced(
 
 static inline void nsquare_narrow(
   residue_narrow_t *result, const residue_narrow_t *x, int n) {
-
-  square_narrow_i(result, x);
-  for (int i = 1; i < n; ++i) {
-    square_narrow_i(result, result);
-  }
+  nsquare_narrow_i(result, x, n);
 }
 
 static void raise_to_t(
@@ -443,20 +371,6 @@ static void raise_to_t2(
   mul_narrow_i(result, &result_t, x);
 }
 
-static void raise_to_phi_t(
-  residue_narrow_t *result, const residue_narrow_t *x, int n) {
-  residue_narrow_t temp;
-
-  raise_to_t(&temp, x);
-
-  for (int i = 1; i < n; ++i) {
-    mul_narrow(&temp, &temp, x);
-    raise_to_t(&temp, &temp);
-  }
-
-  mul_narrow(result, &temp, x);
-}
-
 static void raise_to_t_minus_1_over_4(
   residue_narrow_t *result, const residue_narrow_t *x) {
   // zi = z^(2^i - 1), z1 = x
@@ -532,7 +446,7 @@ int sqrt_inv_narrow(
   return equal_narrow(&should_be_x, x);
 }
 
-void invert_narrow(
+void invert_narrow_fermat(
   residue_narrow_t *result, const residue_narrow_t * __restrict x) {
 
   residue_narrow_t x_t_minus_1_over_4;
@@ -559,6 +473,40 @@ void invert_narrow(
   mul_narrow_i(result, &result_t, &x_t_minus_1);
 }
 
+void invert_narrow(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x) {
+  invert_divsteps(result->limbs, x->limbs);
+}
+
+void invert_narrow_var(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x) {
+  invert_divsteps_var(result->limbs, x->limbs);
+}
+
+void invert_narrow_batch(
+  residue_narrow_t *out, const residue_narrow_t *in, size_t n) {
+  residue_narrow_t acc_inv;
+
+  if (n == 0) {
+    return;
+  }
+
+  // out[i] = in[0] * ... * in[i]
+  copy_narrow(&out[0], &in[0]);
+  for (size_t i = 1; i < n; ++i) {
+    mul_narrow(&out[i], &out[i - 1], &in[i]);
+  }
+
+  // acc_inv is the inverse of in[0] * ... * in[i]. Peel off one input per
+  // step.
+  invert_narrow(&acc_inv, &out[n - 1]);
+  for (size_t i = n - 1; i > 0; --i) {
+    mul_narrow(&out[i], &acc_inv, &out[i - 1]);
+    mul_narrow(&acc_inv, &acc_inv, &in[i]);
+  }
+  copy_narrow(&out[0], &acc_inv);
+}
+
 void encode(uint8_t *out, const residue_narrow_reduced_t * __restrict x) {
   uint32_t collect = x->limbs[0];
 
@@ -0,0 +1 @@
+../../ref/include/f11_260.h
\ No newline at end of file
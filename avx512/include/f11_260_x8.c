@@ -0,0 +1,191 @@
+#include <stdint.h>
+#include "f11_260.h"
+#include "f11_260_x8.h"
+#include "immintrin.h"
+
+#ifdef FIELD_BOUNDS_CHECK
+#include <assert.h>
+
+// The vertical multiplies have the same bounds as the scalar ones. See
+// MUL_LIMB_BOUND.
+static void check_bounds_x8(const residue_x8_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    for (int j = 0; j < LANES_X8; ++j) {
+      assert(x->limbs[i][j] >= -MUL_LIMB_BOUND &&
+             x->limbs[i][j] <= MUL_LIMB_BOUND);
+    }
+  }
+}
+#define CHECK_BOUNDS_X8(x) check_bounds_x8(x)
+#else
+#define CHECK_BOUNDS_X8(x)
+#endif
+
+void pack_x8(residue_x8_t *result, const residue_narrow_t *x) {
+  for (int j = 0; j < LANES_X8; ++j) {
+    for (int i = 0; i < NLIMBS; ++i) {
+      result->limbs[i][j] = x[j].limbs[i];
+    }
+  }
+}
+
+void unpack_x8(residue_narrow_t *result, const residue_x8_t *x) {
+  for (int j = 0; j < LANES_X8; ++j) {
+    for (int i = 0; i < NLIMBS; ++i) {
+      result[j].limbs[i] = x->limbs[i][j];
+    }
+  }
+}
+
+void one_x8(residue_x8_t *result) {
+  _mm512_store_si512((__m512i*) result->limbs[0], _mm512_set1_epi64(1));
+  for (int i = 1; i < NLIMBS; ++i) {
+    _mm512_store_si512((__m512i*) result->limbs[i], _mm512_setzero_si512());
+  }
+}
+
+void copy_x8(residue_x8_t *result, const residue_x8_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    _mm512_store_si512(
+      (__m512i*) result->limbs[i],
+      _mm512_load_si512((__m512i*) x->limbs[i]));
+  }
+}
+
+void add_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    __m512i lhs = _mm512_load_si512((__m512i*) x->limbs[i]);
+    __m512i rhs = _mm512_load_si512((__m512i*) y->limbs[i]);
+    _mm512_store_si512(
+      (__m512i*) result->limbs[i], _mm512_add_epi64(lhs, rhs));
+  }
+}
+
+void sub_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    __m512i lhs = _mm512_load_si512((__m512i*) x->limbs[i]);
+    __m512i rhs = _mm512_load_si512((__m512i*) y->limbs[i]);
+    _mm512_store_si512(
+      (__m512i*) result->limbs[i], _mm512_sub_epi64(lhs, rhs));
+  }
+}
+
+void double_x8(residue_x8_t *result, const residue_x8_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    __m512i lhs = _mm512_load_si512((__m512i*) x->limbs[i]);
+    _mm512_store_si512(
+      (__m512i*) result->limbs[i], _mm512_slli_epi64(lhs, 1));
+  }
+}
+
+void cond_negate_x8(
+  residue_x8_t *result, const residue_x8_t *x, __mmask8 mask) {
+  __m512i zero = _mm512_setzero_si512();
+  for (int i = 0; i < NLIMBS; ++i) {
+    __m512i lhs = _mm512_load_si512((__m512i*) x->limbs[i]);
+    _mm512_store_si512(
+      (__m512i*) result->limbs[i], _mm512_mask_sub_epi64(lhs, mask, zero, lhs));
+  }
+}
+
+// Each limb is in its own register, so the carry from limb i to limb i + 1
+// needs no permutes. The loops in the kernels below are unrolled so that the
+// limbs stay in registers.
+static inline void reduce_step_vectors_x8(__m512i accum[NLIMBS]) {
+  __m512i mask = _mm512_set1_epi64(TMASK);
+  __m512i carries[NLIMBS];
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    carries[i] = _mm512_srai_epi64(accum[i], TBITS);
+    accum[i] = _mm512_and_si512(accum[i], mask);
+    accum[i] = _mm512_add_epi64(
+      accum[i], _mm512_slli_epi64(carries[i], T_CBITS));
+    accum[i] = _mm512_sub_epi64(accum[i], carries[i]);
+  }
+  #pragma clang loop unroll(full)
+  for (int i = 1; i < NLIMBS; ++i) {
+    accum[i] = _mm512_add_epi64(accum[i], carries[i - 1]);
+  }
+  accum[0] = _mm512_add_epi64(accum[0], carries[NLIMBS - 1]);
+}
+
+void reduce_step_x8(residue_x8_t *result, const residue_x8_t *x) {
+  __m512i accum[NLIMBS];
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    accum[i] = _mm512_load_si512((__m512i*) x->limbs[i]);
+  }
+  reduce_step_vectors_x8(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    _mm512_store_si512((__m512i*) result->limbs[i], accum[i]);
+  }
+}
+
+// Limbs of x, repeated so that limbs i - 5 through i + 5 of limb i can be
+// indexed without wrapping: result[k + 5] is limb k of x, for -5 <= k < 16.
+static inline void load_extended_x8(
+  __m512i result[NLIMBS + 10], const residue_x8_t *x) {
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS + 10; ++i) {
+    result[i] = _mm512_load_si512(
+      (__m512i*) x->limbs[(i + NLIMBS - 5) % NLIMBS]);
+  }
+}
+
+// The same schedule as mul_narrow in the ref backend, with one element per
+// lane. The 32-bit differences are sign extended by _mm512_mul_epi32.
+void mul_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y) {
+  CHECK_BOUNDS_X8(x);
+  CHECK_BOUNDS_X8(y);
+
+  __m512i lhs[NLIMBS + 10], rhs[NLIMBS + 10];
+  __m512i accum[NLIMBS];
+  load_extended_x8(lhs, x);
+  load_extended_x8(rhs, y);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    int i_2 = ((i + (-(i & 1) & NLIMBS)) >> 1) + 5;
+    accum[i] = _mm512_setzero_si512();
+    #pragma clang loop unroll(full)
+    for (int j = 1; j <= NLIMBS / 2; ++j) {
+      __m512i sublhs = _mm512_sub_epi32(lhs[i_2 + j], lhs[i_2 - j]);
+      __m512i subrhs = _mm512_sub_epi32(rhs[i_2 - j], rhs[i_2 + j]);
+      accum[i] = _mm512_add_epi64(
+        accum[i], _mm512_mul_epi32(sublhs, subrhs));
+    }
+  }
+  reduce_step_vectors_x8(accum);
+  reduce_step_vectors_x8(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    _mm512_store_si512((__m512i*) result->limbs[i], accum[i]);
+  }
+}
+
+void square_x8(residue_x8_t *result, const residue_x8_t *x) {
+  CHECK_BOUNDS_X8(x);
+  __m512i lhs[NLIMBS + 10];
+  __m512i accum[NLIMBS];
+  load_extended_x8(lhs, x);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    int i_2 = ((i + (-(i & 1) & NLIMBS)) >> 1) + 5;
+    accum[i] = _mm512_setzero_si512();
+    #pragma clang loop unroll(full)
+    for (int j = 1; j <= NLIMBS / 2; ++j) {
+      __m512i sub = _mm512_sub_epi32(lhs[i_2 + j], lhs[i_2 - j]);
+      accum[i] = _mm512_sub_epi64(accum[i], _mm512_mul_epi32(sub, sub));
+    }
+  }
+  reduce_step_vectors_x8(accum);
+  reduce_step_vectors_x8(accum);
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    _mm512_store_si512((__m512i*) result->limbs[i], accum[i]);
+  }
+}
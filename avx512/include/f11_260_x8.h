@@ -0,0 +1,55 @@
+// Eight independent field elements, stored limb by limb so that each 64-bit
+// lane of a 512-bit register holds a different element. Every operation is
+// applied to all eight elements at once, with no shuffling between lanes. Used
+// to run eight scalar multiplications in lockstep.
+
+#ifndef F11_260_X8_H
+#define F11_260_X8_H
+#include <stdint.h>
+#include "f11_260.h"
+#include "immintrin.h"
+
+#define LANES_X8 8
+
+// limbs[i][j] is limb i of element j. Reduced elements fit in 32 bits, sign
+// extended to 64.
+typedef struct residue_x8 {
+  __attribute__((__aligned__(64)))
+  int64_t limbs[NLIMBS][LANES_X8];
+} residue_x8_t;
+
+// Gather the eight narrow residues x[0] .. x[7] into the lanes of result.
+void pack_x8(residue_x8_t *result, const residue_narrow_t *x);
+
+// Scatter lane j of x into the narrow residue result[j].
+void unpack_x8(residue_narrow_t *result, const residue_x8_t *x);
+
+// Set every lane to one.
+void one_x8(residue_x8_t *result);
+
+void copy_x8(residue_x8_t *result, const residue_x8_t *x);
+
+// Add each lane.
+void add_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y);
+
+// Subtract each lane.
+void sub_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y);
+
+// Scale each lane by 2.
+void double_x8(residue_x8_t *result, const residue_x8_t *x);
+
+// Negate the lanes that are set in mask. Other lanes are copied.
+void cond_negate_x8(residue_x8_t *result, const residue_x8_t *x, __mmask8 mask);
+
+// Multiply each lane. The result is reduced to 32 bits.
+void mul_x8(
+  residue_x8_t *result, const residue_x8_t *x, const residue_x8_t *y);
+
+// Square each lane. The result is reduced to 32 bits.
+void square_x8(residue_x8_t *result, const residue_x8_t *x);
+
+// Approximately divide each coefficient of each lane by t. Carry the results.
+void reduce_step_x8(residue_x8_t *result, const residue_x8_t *x);
+#endif
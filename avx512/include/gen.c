@@ -0,0 +1 @@
+../../ref/include/gen.c
\ No newline at end of file
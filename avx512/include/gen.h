@@ -0,0 +1 @@
+../../ref/include/gen.h
\ No newline at end of file
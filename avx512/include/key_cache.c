@@ -0,0 +1 @@
+../../ref/include/key_cache.c
\ No newline at end of file
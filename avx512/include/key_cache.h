@@ -0,0 +1 @@
+../../ref/include/key_cache.h
\ No newline at end of file
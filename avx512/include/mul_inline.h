@@ -0,0 +1,197 @@
+// Inline multiplication, squaring and reduction for the AVX-512 backend. A
+// narrow residue fits in one 512-bit register: 16 32-bit lanes, of which the
+// first NLIMBS are used. A wide residue fits in two registers of 8 64-bit
+// lanes.
+
+#ifndef MUL_INLINE_H
+#define MUL_INLINE_H
+#include <stdint.h>
+#include "f11_260.h"
+#include "immintrin.h"
+
+// Coefficient i of a product is the sum over j = 1 .. 5 of
+// (x[k + j] - x[k - j]) * (y[k - j] - y[k + j]), where k = i / 2 mod 11. The
+// terms are computed in k order, so that each difference is a subtraction of
+// two rotations of x, and then permuted into i order.
+
+// ROTATE_LIMBS[r - 1][k] = (k + r) mod 11.
+__attribute__((__aligned__(64)))
+static const int32_t ROTATE_LIMBS[10][16] = {
+  { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 0, 0, 0, 0, 0, },
+  { 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 0, 0, 0, 0, 0, },
+  { 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 0, 0, 0, 0, 0, },
+  { 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 0, 0, 0, 0, 0, },
+  { 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, },
+  { 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 0, 0, 0, 0, 0, },
+  { 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, },
+  { 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, },
+  { 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, },
+  { 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, },
+};
+
+// Even k terms are accumulated in lanes k / 2 of one register, and odd k terms
+// in lanes k / 2 of another. These pick coefficients 0 .. 7 and 8 .. 10 out of
+// that pair. Coefficient i comes from k = 6 * i mod 11.
+__attribute__((__aligned__(64)))
+static const int64_t K_TO_I_LOW[8] = { 0, 3, 8, 11, 1, 4, 9, 12, };
+__attribute__((__aligned__(64)))
+static const int64_t K_TO_I_HIGH[8] = { 2, 5, 10, 0, 0, 0, 0, 0, };
+
+// Carries move from coefficient i to coefficient i + 1, and from 10 to 0.
+__attribute__((__aligned__(64)))
+static const int64_t CARRY_LOW[8] = { 10, 0, 1, 2, 3, 4, 5, 6, };
+__attribute__((__aligned__(64)))
+static const int64_t CARRY_HIGH[8] = { 7, 8, 9, 0, 0, 0, 0, 0, };
+__attribute__((__aligned__(64)))
+static const int32_t CARRY_NARROW[16] = {
+  10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0,
+};
+
+// Only the lanes that hold limbs.
+#define LIMB_MASK_WIDE_HIGH ((__mmask8) 0x07)
+#define LIMB_MASK_NARROW ((__mmask16) 0x7ff)
+
+// Approximately divide each coefficient by t. Carry the results. low holds
+// coefficients 0 .. 7 and high holds 8 .. 10.
+static inline void reduce_step_wide_vec(__m512i *low, __m512i *high) {
+  __m512i mask = _mm512_set1_epi64(TMASK);
+  __m512i carry_low = _mm512_srai_epi64(*low, TBITS);
+  __m512i carry_high = _mm512_srai_epi64(*high, TBITS);
+  __m512i l = _mm512_and_si512(*low, mask);
+  __m512i h = _mm512_and_si512(*high, mask);
+  l = _mm512_add_epi64(l, _mm512_slli_epi64(carry_low, T_CBITS));
+  h = _mm512_add_epi64(h, _mm512_slli_epi64(carry_high, T_CBITS));
+  l = _mm512_sub_epi64(l, carry_low);
+  h = _mm512_sub_epi64(h, carry_high);
+  __m512i moved_low = _mm512_permutex2var_epi64(
+    carry_low, _mm512_load_si512((__m512i *) CARRY_LOW), carry_high);
+  __m512i moved_high = _mm512_maskz_permutex2var_epi64(
+    LIMB_MASK_WIDE_HIGH, carry_low,
+    _mm512_load_si512((__m512i *) CARRY_HIGH), carry_high);
+  *low = _mm512_add_epi64(l, moved_low);
+  *high = _mm512_add_epi64(h, moved_high);
+}
+
+// Pack the 64-bit coefficients of a reduced product down to 32 bits.
+static inline __m512i narrow_vec(__m512i low, __m512i high) {
+  return _mm512_inserti64x4(
+    _mm512_castsi256_si512(_mm512_cvtepi64_epi32(low)),
+    _mm512_cvtepi64_epi32(high), 1);
+}
+
+// Sum of the products of the lanes of dx and dy, with even k in the returned
+// low lanes of *even and odd k in *odd. The differences are 32 bits, so only
+// the low half of each 64-bit lane is multiplied.
+static inline void mul_diffs_accum(
+  __m512i *even, __m512i *odd, __m512i dx, __m512i dy) {
+  *even = _mm512_add_epi64(*even, _mm512_mul_epi32(dx, dy));
+  *odd = _mm512_add_epi64(*odd, _mm512_mul_epi32(
+    _mm512_srli_epi64(dx, 32), _mm512_srli_epi64(dy, 32)));
+}
+
+static inline __m512i rotate_limbs(__m512i x, int r) {
+  return _mm512_permutexvar_epi32(
+    _mm512_load_si512((__m512i *) ROTATE_LIMBS[r - 1]), x);
+}
+
+// Reduce the k ordered sums twice, and return them narrowed in i order.
+static inline __m512i finish_product(__m512i even, __m512i odd) {
+  __m512i low = _mm512_permutex2var_epi64(
+    even, _mm512_load_si512((__m512i *) K_TO_I_LOW), odd);
+  __m512i high = _mm512_maskz_permutex2var_epi64(
+    LIMB_MASK_WIDE_HIGH, even, _mm512_load_si512((__m512i *) K_TO_I_HIGH),
+    odd);
+  reduce_step_wide_vec(&low, &high);
+  reduce_step_wide_vec(&low, &high);
+  return narrow_vec(low, high);
+}
+
+static inline void mul_narrow_i(
+  residue_narrow_t *result, const residue_narrow_t *x,
+  const residue_narrow_t *y) {
+  CHECK_BOUNDS_NARROW(x);
+  CHECK_BOUNDS_NARROW(y);
+
+  __m512i xv = _mm512_load_si512((__m512i *) &x->limbs[0]);
+  __m512i yv = _mm512_load_si512((__m512i *) &y->limbs[0]);
+  __m512i even = _mm512_setzero_si512();
+  __m512i odd = _mm512_setzero_si512();
+
+  #pragma clang loop unroll(full)
+  for (int j = 1; j <= NLIMBS / 2; ++j) {
+    // x[k + j] - x[k - j], and the same for y. The product wants
+    // y[k - j] - y[k + j], so the sum is subtracted instead.
+    __m512i dx = _mm512_sub_epi32(
+      rotate_limbs(xv, j), rotate_limbs(xv, NLIMBS - j));
+    __m512i dy = _mm512_sub_epi32(
+      rotate_limbs(yv, NLIMBS - j), rotate_limbs(yv, j));
+    mul_diffs_accum(&even, &odd, dx, dy);
+  }
+
+  _mm512_store_si512((__m512i *) &result->limbs[0], finish_product(even, odd));
+}
+
+static inline __m512i square_narrow_vec(__m512i xv) {
+  __m512i even = _mm512_setzero_si512();
+  __m512i odd = _mm512_setzero_si512();
+
+  #pragma clang loop unroll(full)
+  for (int j = 1; j <= NLIMBS / 2; ++j) {
+    __m512i dx = _mm512_sub_epi32(
+      rotate_limbs(xv, NLIMBS - j), rotate_limbs(xv, j));
+    __m512i neg_dx = _mm512_sub_epi32(_mm512_setzero_si512(), dx);
+    mul_diffs_accum(&even, &odd, dx, neg_dx);
+  }
+
+  return finish_product(even, odd);
+}
+
+static inline void square_narrow_i(
+  residue_narrow_t *result, const residue_narrow_t *x) {
+  CHECK_BOUNDS_NARROW(x);
+
+  __m512i xv = _mm512_load_si512((__m512i *) &x->limbs[0]);
+  _mm512_store_si512((__m512i *) &result->limbs[0], square_narrow_vec(xv));
+}
+
+// Square x n times, with x in a register throughout. A square's output is
+// within the bounds for its input, so only x needs checking.
+static inline void nsquare_narrow_i(
+  residue_narrow_t *result, const residue_narrow_t *x, int n) {
+  CHECK_BOUNDS_NARROW(x);
+
+  __m512i xv = _mm512_load_si512((__m512i *) &x->limbs[0]);
+  for (int i = 0; i < n; ++i) {
+    xv = square_narrow_vec(xv);
+  }
+  _mm512_store_si512((__m512i *) &result->limbs[0], xv);
+}
+
+static inline __m512i reduce_step_narrow_vec(__m512i xv) {
+  __m512i carry = _mm512_srai_epi32(xv, TBITS);
+  __m512i r = _mm512_and_si512(xv, _mm512_set1_epi32(TMASK));
+  r = _mm512_add_epi32(r, _mm512_slli_epi32(carry, T_CBITS));
+  r = _mm512_sub_epi32(r, carry);
+  __m512i moved = _mm512_maskz_permutexvar_epi32(
+    LIMB_MASK_NARROW, _mm512_load_si512((__m512i *) CARRY_NARROW), carry);
+  return _mm512_add_epi32(r, moved);
+}
+
+static inline void reduce_step_narrow_i(
+  residue_narrow_t *result, const residue_narrow_t *x) {
+
+  __m512i xv = _mm512_load_si512((__m512i *) &x->limbs[0]);
+  _mm512_store_si512(
+    (__m512i *) &result->limbs[0], reduce_step_narrow_vec(xv));
+}
+
+static inline void reduce_step_wide_i(
+  residue_wide_t *result, const residue_wide_t *x) {
+
+  __m512i low = _mm512_load_si512((__m512i *) &x->limbs[0]);
+  __m512i high = _mm512_load_si512((__m512i *) &x->limbs[8]);
+  reduce_step_wide_vec(&low, &high);
+  _mm512_store_si512((__m512i *) &result->limbs[0], low);
+  _mm512_store_si512((__m512i *) &result->limbs[8], high);
+}
+#endif
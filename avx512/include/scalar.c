@@ -0,0 +1 @@
+../../ref/include/scalar.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/scalar.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/include/sign.h
\ No newline at end of file
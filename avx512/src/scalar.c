@@ -1 +0,0 @@
-../../ref/src/scalar.c
\ No newline at end of file
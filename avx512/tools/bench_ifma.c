@@ -0,0 +1,200 @@
+// Compares the IFMA field multiply in f52_260.c with mul_wide from the avx2
+// backend, after checking that the two agree. Build with ../avx2/include ahead
+// of include, so that f11_260.c is the avx2 version. See the bench_ifma target
+// in the Makefile.
+#define _DEFAULT_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "f11_260.h"
+#include "f52_260.h"
+
+#include "f11_260.c"
+#include "f52_260.c"
+
+#define BENCH_ITERATIONS 100000
+// Report the fastest of several runs, to filter out scheduling noise.
+#define BENCH_RUNS 10
+#define CHECK_ITERATIONS 1000
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void random_reduced(residue_narrow_reduced_t *result) {
+  uint8_t bytes[RESIDUE_LENGTH_BYTES];
+  for (int i = 0; i < RESIDUE_LENGTH_BYTES; ++i) {
+    bytes[i] = rand();
+  }
+  decode(result, bytes);
+}
+
+static void reduced_to_wide(
+  residue_wide_t *result, const residue_narrow_reduced_t *x) {
+  residue_narrow_t narrow_x;
+  unnarrow_reduce(&narrow_x, x);
+  widen(result, &narrow_x);
+}
+
+static void wide_to_reduced(
+  residue_narrow_reduced_t *result, const residue_wide_t *x) {
+  residue_narrow_t narrow_x;
+  narrow(&narrow_x, x);
+  narrow_complete(result, &narrow_x);
+}
+
+static void check_agreement(void) {
+  for (int i = 0; i < CHECK_ITERATIONS; ++i) {
+    residue_narrow_reduced_t a, b, expected, actual;
+    residue_wide_t a_wide, b_wide, c_wide;
+    residue52_t a52, b52, c52;
+    uint8_t encoded[RESIDUE_LENGTH_BYTES];
+    uint8_t encoded52[RESIDUE_LENGTH_BYTES];
+
+    random_reduced(&a);
+    random_reduced(&b);
+    reduced_to_wide(&a_wide, &a);
+    reduced_to_wide(&b_wide, &b);
+    residue52_from_reduced(&a52, &a);
+    residue52_from_reduced(&b52, &b);
+
+    wide_to_reduced(&expected, &a_wide);
+    residue52_to_reduced(&actual, &a52);
+    assert(equal_narrow_reduced(&expected, &actual));
+
+    mul_wide(&c_wide, &a_wide, &b_wide);
+    mul52(&c52, &a52, &b52);
+    wide_to_reduced(&expected, &c_wide);
+    residue52_to_reduced(&actual, &c52);
+    assert(equal_narrow_reduced(&expected, &actual));
+
+    encode(encoded, &expected);
+    encode52(encoded52, &c52);
+    for (int j = 0; j < RESIDUE_LENGTH_BYTES; ++j) {
+      assert(encoded[j] == encoded52[j]);
+    }
+    decode52(&c52, encoded);
+    residue52_to_reduced(&actual, &c52);
+    assert(equal_narrow_reduced(&expected, &actual));
+
+    // (a + b)^2 - ab
+    add_wide(&c_wide, &a_wide, &b_wide);
+    square_wide(&c_wide, &c_wide);
+    mul_wide(&a_wide, &a_wide, &b_wide);
+    sub_wide(&c_wide, &c_wide, &a_wide);
+    reduce_step_wide(&c_wide, &c_wide);
+    add52(&c52, &a52, &b52);
+    square52(&c52, &c52);
+    mul52(&a52, &a52, &b52);
+    sub52(&c52, &c52, &a52);
+    mul52(&c52, &c52, &one52);
+    wide_to_reduced(&expected, &c_wide);
+    residue52_to_reduced(&actual, &c52);
+    assert(equal_narrow_reduced(&expected, &actual));
+  }
+}
+
+static double time_mul_wide(residue_wide_t *x, const residue_wide_t *y) {
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      mul_wide(x, x, y);
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+static double time_square_wide(residue_wide_t *x) {
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      square_wide(x, x);
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+static double time_mul52(residue52_t *x, const residue52_t *y) {
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      mul52(x, x, y);
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+static double time_square52(residue52_t *x) {
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      square52(x, x);
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+static double time_round_trip(residue52_t *x) {
+  residue_narrow_reduced_t reduced;
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS / 100; ++i) {
+      residue52_to_reduced(&reduced, x);
+      residue52_from_reduced(x, &reduced);
+    }
+    double elapsed = (now_ns() - start) / (BENCH_ITERATIONS / 100);
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+int main(void) {
+  residue_narrow_reduced_t a, b;
+  residue_wide_t a_wide, b_wide;
+  residue52_t a52, b52;
+
+  check_agreement();
+
+  random_reduced(&a);
+  random_reduced(&b);
+  reduced_to_wide(&a_wide, &a);
+  reduced_to_wide(&b_wide, &b);
+  residue52_from_reduced(&a52, &a);
+  residue52_from_reduced(&b52, &b);
+
+  // Each timed loop is a chain of dependent operations, so these are
+  // latencies.
+  printf("avx2 mul_wide: %.1f ns\n", time_mul_wide(&a_wide, &b_wide));
+  printf("ifma mul52: %.1f ns\n", time_mul52(&a52, &b52));
+  printf("avx2 square_wide: %.1f ns\n", time_square_wide(&a_wide));
+  printf("ifma square52: %.1f ns\n", time_square52(&a52));
+  printf("ifma conversion round trip: %.1f ns\n", time_round_trip(&a52));
+  return 0;
+}
@@ -0,0 +1 @@
+../../ref/tools/bench_invert.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/tools/bench_scalar_mult.c
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include <stdint.h>
+#include "divsteps.h"
+#include "f11_260.h"
+#include "f52_260.h"
+#include "immintrin.h"
+
+residue52_t zero52 = {0};
+// R mod p
+residue52_t one52 = {
+  .limbs = {
+    0xaf944321f6d3a, 0xc5f9ff0982c42, 0xcdae9e146ea9f, 0x1690cc199423,
+    0x2c6983a33cb3, 0x0,
+  },
+};
+
+__attribute__((__aligned__(64)))
+static const uint64_t P52[8] = {
+  0xf59a43ada019b, 0x21080a5afc1a8, 0x3da3cc113d64a, 0xfe7c4949dfd17,
+  0xffffdac002706, 0x0,
+};
+
+// -1/p mod 2^52
+#define P52_NEG_INV 0xf91158e41836dULL
+
+// R^2 mod p. Multiplying by this converts into Montgomery form.
+static const residue52_t R2_52 = {
+  .limbs = {
+    0xbdb1dbb74f681, 0x2b45497401fe5, 0x92a964ef11b4, 0xd13ef7e84cf14,
+    0xedcc65a023570, 0x0,
+  },
+};
+
+// Plain 1. Multiplying by this converts out of Montgomery form.
+static const residue52_t ONE_PLAIN_52 = {
+  .limbs = {1},
+};
+
+// 4p, with 2^52 borrowed into each of the low 5 limbs, so that subtracting a
+// normalized value from it can't make a lane negative.
+__attribute__((__aligned__(64)))
+static const uint64_t FOUR_P52_SPREAD[8] = {
+  0x1d6690eb68066c, 0x18420296bf06a2, 0x1f68f3044f5927, 0x1f9f125277f45b,
+  0x1ffff6b0009c1a, 0x2,
+};
+
+// Limbs less than 2^57 are carried so that each is less than 2^52. After one
+// round of shifted carries, a lane can exceed 2^52 - 1 by at most 31, so any
+// further carry is a single bit. Those are resolved together using the mask
+// registers: a lane generates a carry if it is too big, and propagates one if
+// it is exactly 2^52 - 1.
+static inline __m512i normalize52(__m512i x) {
+  __m512i mask = _mm512_set1_epi64(LIMB52_MASK);
+  __m512i carry = _mm512_srli_epi64(x, LIMB52_BITS);
+  x = _mm512_and_si512(x, mask);
+  x = _mm512_add_epi64(
+    x, _mm512_alignr_epi64(carry, _mm512_setzero_si512(), 7));
+
+  __mmask8 generate = _mm512_cmpgt_epu64_mask(x, mask);
+  __mmask8 propagate = _mm512_cmpeq_epu64_mask(x, mask);
+  __mmask8 carry_in = ((generate << 1) + propagate) ^ propagate;
+  x = _mm512_mask_add_epi64(x, carry_in, x, _mm512_set1_epi64(1));
+  return _mm512_and_si512(x, mask);
+}
+
+// Shift y up s limbs. Limbs that end up in lanes 8 and above go in *high.
+static inline void shift_up52(__m512i *low, __m512i *high, __m512i y, int s) {
+  __m512i index = _mm512_sub_epi64(
+    _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi64(s));
+  uint32_t lanes = ((1 << NLIMBS_52) - 1) << s;
+  *low = _mm512_maskz_permutexvar_epi64(lanes & 0xff, index, y);
+  *high = _mm512_maskz_permutexvar_epi64(lanes >> 8, index, y);
+}
+
+// Montgomery multiplication. The full product is formed first. Its products
+// are all independent, so they pipeline. The low halves and high halves of the
+// partial products are summed separately to keep the dependency chains short.
+// Then each reduction step adds m * p, where m is chosen to clear the low limb,
+// and shifts down a limb. The high halves of m * p belong one limb up, so they
+// are added after the shift. Only the reduction is serial.
+static inline __m512i mul52_i(__m512i x, __m512i y) {
+  __m512i zero = _mm512_setzero_si512();
+  __m512i p = _mm512_load_si512((__m512i *) P52);
+  __m512i neg_inv = _mm512_set1_epi64(P52_NEG_INV);
+  __m512i y_low[NLIMBS_52 + 1];
+  __m512i y_high[NLIMBS_52 + 1];
+  __m512i lo_low = zero, lo_high = zero, hi_low = zero, hi_high = zero;
+
+  #pragma clang loop unroll(full)
+  for (int s = 0; s <= NLIMBS_52; ++s) {
+    shift_up52(&y_low[s], &y_high[s], y, s);
+  }
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_52; ++i) {
+    __m512i xi = _mm512_permutexvar_epi64(_mm512_set1_epi64(i), x);
+    lo_low = _mm512_madd52lo_epu64(lo_low, xi, y_low[i]);
+    lo_high = _mm512_madd52lo_epu64(lo_high, xi, y_high[i]);
+    hi_low = _mm512_madd52hi_epu64(hi_low, xi, y_low[i + 1]);
+    hi_high = _mm512_madd52hi_epu64(hi_high, xi, y_high[i + 1]);
+  }
+  __m512i low = _mm512_add_epi64(lo_low, hi_low);
+  __m512i high = _mm512_add_epi64(lo_high, hi_high);
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_52; ++i) {
+    __m512i m = _mm512_madd52lo_epu64(zero, low, neg_inv);
+    m = _mm512_permutexvar_epi64(zero, m);
+    low = _mm512_madd52lo_epu64(low, m, p);
+    __m512i carry = _mm512_maskz_srli_epi64(0x01, low, LIMB52_BITS);
+    low = _mm512_alignr_epi64(high, low, 1);
+    high = _mm512_alignr_epi64(zero, high, 1);
+    low = _mm512_add_epi64(low, carry);
+    low = _mm512_madd52hi_epu64(low, m, p);
+  }
+
+  return normalize52(low);
+}
+
+void reduce_step52(residue52_t *result, const residue52_t *x) {
+  __m512i xv = _mm512_load_si512((__m512i *) x->limbs);
+  _mm512_store_si512((__m512i *) result->limbs, normalize52(xv));
+}
+
+void add52(residue52_t *result, const residue52_t *x, const residue52_t *y) {
+  __m512i xv = _mm512_load_si512((__m512i *) x->limbs);
+  __m512i yv = _mm512_load_si512((__m512i *) y->limbs);
+  _mm512_store_si512(
+    (__m512i *) result->limbs, normalize52(_mm512_add_epi64(xv, yv)));
+}
+
+void sub52(residue52_t *result, const residue52_t *x, const residue52_t *y) {
+  __m512i xv = _mm512_load_si512((__m512i *) x->limbs);
+  __m512i yv = _mm512_load_si512((__m512i *) y->limbs);
+  __m512i four_p = _mm512_load_si512((__m512i *) FOUR_P52_SPREAD);
+  __m512i diff = _mm512_add_epi64(xv, _mm512_sub_epi64(four_p, yv));
+  _mm512_store_si512((__m512i *) result->limbs, normalize52(diff));
+}
+
+void mul52(residue52_t *result, const residue52_t *x, const residue52_t *y) {
+  __m512i xv = _mm512_load_si512((__m512i *) x->limbs);
+  __m512i yv = _mm512_load_si512((__m512i *) y->limbs);
+  _mm512_store_si512((__m512i *) result->limbs, mul52_i(xv, yv));
+}
+
+void square52(residue52_t *result, const residue52_t *x) {
+  __m512i xv = _mm512_load_si512((__m512i *) x->limbs);
+  _mm512_store_si512((__m512i *) result->limbs, mul52_i(xv, xv));
+}
+
+// The conversions go through a plain integer, held as 26-bit digits so that
+// multiplying or dividing a digit by t fits in 64 bits.
+#define NDIGITS_26 (2 * NLIMBS_52)
+
+static void pack_digits(residue52_t *result, const uint64_t *digits) {
+  for (int i = 0; i < NLIMBS_52; ++i) {
+    result->limbs[i] = digits[2 * i] | (digits[2 * i + 1] << TBITS);
+  }
+  result->limbs[6] = result->limbs[7] = 0;
+}
+
+static void unpack_digits(uint64_t *digits, const residue52_t *x) {
+  for (int i = 0; i < NLIMBS_52; ++i) {
+    digits[2 * i] = x->limbs[i] & TMASK;
+    digits[2 * i + 1] = x->limbs[i] >> TBITS;
+  }
+}
+
+void residue52_from_reduced(
+  residue52_t *result, const residue_narrow_reduced_t * __restrict x) {
+
+  uint64_t digits[NDIGITS_26] = {0};
+  residue52_t plain;
+
+  // Horner's rule: v = v * t + x_i. The value stays below 2^287.
+  for (int i = NLIMBS_REDUCED - 1; i >= 0; --i) {
+    uint64_t carry = (uint32_t) x->limbs[i];
+    for (int j = 0; j < NDIGITS_26; ++j) {
+      uint64_t d = digits[j] * T + carry;
+      digits[j] = d & TMASK;
+      carry = d >> TBITS;
+    }
+  }
+  pack_digits(&plain, digits);
+  mul52(result, &plain, &R2_52);
+}
+
+void residue52_to_reduced(
+  residue_narrow_reduced_t *result, const residue52_t * __restrict x) {
+
+  uint64_t digits[NDIGITS_26];
+  residue52_t plain;
+  residue_narrow_reduced_t t_adic;
+  residue_narrow_t temp;
+
+  // Leaving Montgomery form gives a value that is at most p.
+  mul52(&plain, x, &ONE_PLAIN_52);
+  unpack_digits(digits, &plain);
+
+  // Repeated division by t produces the t-adic limbs. Each dividend is less
+  // than 2^52, so the reciprocal gives the exact quotient in constant time.
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    uint64_t rem = 0;
+    for (int j = NDIGITS_26 - 1; j >= 0; --j) {
+      uint64_t cur = (rem << TBITS) | digits[j];
+      uint64_t quot = ((unsigned __int128) cur * RECIP_T) >> RECIP_T_SHIFT;
+      rem = cur - quot * T;
+      digits[j] = quot;
+    }
+    t_adic.limbs[i] = rem;
+  }
+
+  // What is left is 0 or 1 times t^10, and t^10 = -(1 + t + ... + t^9).
+  int32_t top = digits[0];
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    t_adic.limbs[i] -= top;
+  }
+  unnarrow_reduce(&temp, &t_adic);
+  narrow_complete(result, &temp);
+}
+
+void encode52(uint8_t *out, const residue52_t * __restrict x) {
+  residue_narrow_reduced_t reduced;
+  residue52_to_reduced(&reduced, x);
+  encode(out, &reduced);
+}
+
+void decode52(residue52_t *out, const uint8_t *in) {
+  residue_narrow_reduced_t reduced;
+  decode(&reduced, in);
+  residue52_from_reduced(out, &reduced);
+}
@@ -0,0 +1,57 @@
+// Field elements in Montgomery form with 52-bit limbs, for the AVX-512 IFMA
+// multiply-add instructions. This is an alternative to the t-adic limbs of
+// f11_260.h. The two only meet at the encode/decode boundary: convert once on
+// the way in and once on the way out. Only bench_ifma uses it: its multiply is
+// slower than the avx2 one, so it isn't part of the library.
+
+#ifndef F52_260_H
+#define F52_260_H
+#include <stdint.h>
+#include "f11_260.h"
+
+// 6 limbs of 52 bits. Montgomery multiplication needs R > 4p, and p is 260
+// bits, so R = 2^312.
+#define NLIMBS_52 6
+#define LIMB52_BITS 52
+#define LIMB52_MASK ((1ULL << 52) - 1)
+
+// x * R mod p, one limb per 64-bit lane of a 512-bit register. The top two
+// lanes are always zero. The value is only partially reduced: mul52 and
+// square52 produce values less than 2p.
+typedef struct residue52 {
+  __attribute__((__aligned__(64)))
+  uint64_t limbs[8];
+} residue52_t;
+
+residue52_t zero52;
+residue52_t one52;
+
+// Convert from the t-adic representation. The limbs of x must be in [0, 2^26),
+// as produced by decode or narrow_complete.
+void residue52_from_reduced(
+  residue52_t *result, const residue_narrow_reduced_t * __restrict x);
+
+// Convert to the unique t-adic representative, as narrow_complete would.
+void residue52_to_reduced(
+  residue_narrow_reduced_t *result, const residue52_t * __restrict x);
+
+void encode52(uint8_t *out, const residue52_t * __restrict x);
+
+void decode52(residue52_t *out, const uint8_t *in);
+
+// Carry so that every limb is less than 2^52. The multiply instructions only
+// read the low 52 bits of each lane.
+void reduce_step52(residue52_t *result, const residue52_t *x);
+
+// x + y. The result is less than 4p if both inputs are less than 2p.
+void add52(residue52_t *result, const residue52_t *x, const residue52_t *y);
+
+// x - y + 4p. y must be less than 2p, such as a result of mul52.
+void sub52(residue52_t *result, const residue52_t *x, const residue52_t *y);
+
+// Montgomery multiplication: x * y / R mod p. Inputs may be any sum of a few
+// partially reduced values. The result is less than 2p.
+void mul52(residue52_t *result, const residue52_t *x, const residue52_t *y);
+
+void square52(residue52_t *result, const residue52_t *x);
+#endif
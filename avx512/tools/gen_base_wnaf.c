@@ -0,0 +1 @@
+../../ref/tools/gen_base_wnaf.c
\ No newline at end of file
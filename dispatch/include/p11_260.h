@@ -0,0 +1,53 @@
+// Byte level interface to p11_260, with the backend chosen at load time.
+//
+// The library contains the ref, avx2 and avx512 backends, each compiled for
+// its own instruction set. When the library is loaded, the fastest backend
+// that the CPU supports is selected. The environment variable
+// P11_260_BACKEND can name a slower one instead. All backends produce and
+// accept the same encodings, so keys and signatures can move between hosts
+// that use different backends.
+
+#ifndef P11_260_H
+#define P11_260_H
+#include <stddef.h>
+#include <stdint.h>
+
+#define P11_260_PUBLIC_KEY_BYTES 33
+#define P11_260_SCALAR_BYTES 33
+// The private scalar followed by the public key.
+#define P11_260_SECRET_KEY_BYTES \
+  (P11_260_SCALAR_BYTES + P11_260_PUBLIC_KEY_BYTES)
+#define P11_260_SIGNATURE_BYTES 65
+// Points are encoded the same way as public keys.
+#define P11_260_POINT_BYTES P11_260_PUBLIC_KEY_BYTES
+
+void p11_260_gen_key(uint8_t *secret_key, uint8_t *public_key);
+
+void p11_260_sign(
+  uint8_t *sig, const uint8_t *secret_key, const uint8_t *msg,
+  size_t msg_len);
+
+// Returns 1 if sig is a valid signature of msg, and 0 otherwise. Also returns
+// 0 if public_key doesn't decode.
+int p11_260_verify(
+  const uint8_t *sig, const uint8_t *public_key, const uint8_t *msg,
+  size_t msg_len);
+
+// Computes scalar * B with the base point comb, in constant time. Bits of the
+// scalar above the 258th are ignored.
+void p11_260_scalar_mult_base(uint8_t *result, const uint8_t *scalar);
+
+// Computes scalar * point in constant time. Returns 0, and leaves result
+// alone, if point doesn't decode. Bits of the scalar above the 258th are
+// ignored.
+int p11_260_scalar_mult(
+  uint8_t *result, const uint8_t *scalar, const uint8_t *point);
+
+// Name of the backend in use: "ref", "avx2" or "avx512".
+const char *p11_260_backend(void);
+
+// Switches to the named backend. Returns 0, and leaves the current backend in
+// place, if the name is unknown or the CPU doesn't support it. Not thread safe
+// with respect to concurrent calls into the library.
+int p11_260_use_backend(const char *name);
+#endif
@@ -0,0 +1,92 @@
+// Byte level entry points for one backend. Compiled once per backend, with
+// that backend's include and src directories on the include path, and BACKEND
+// set to its name. The whole backend is pulled in through its sign.c, so that
+// it stays a single translation unit. sign.c comes first, because it sets the
+// feature test macros.
+#include "sign.c"
+
+#include <string.h>
+#include "backend.h"
+
+#define BACKEND_EXPORT __attribute__((__visibility__("default")))
+
+#ifdef BACKEND_WIDE_POINTS
+// The avx2 backend keeps projective points in wide residues.
+typedef projective_pt_wide_t backend_projective_pt_t;
+#else
+typedef projective_pt_narrow_t backend_projective_pt_t;
+#endif
+
+static void decode_scalar(scalar_t *result, const uint8_t *bytes) {
+  result->limbs[SCALAR_LIMBS - 1] = 0;
+  memcpy(result, bytes, SCALAR_BYTES);
+  result->limbs[SCALAR_LIMBS - 1] &= SCALAR_LAST_LIMB_MASK;
+}
+
+BACKEND_EXPORT void BACKEND_CONCAT(BACKEND, gen_key)(
+  uint8_t *secret_key, uint8_t *public_key) {
+
+  affine_pt_narrow_t pub_key_pt;
+  scalar_t priv_key;
+  gen_key(&priv_key, &pub_key_pt);
+  encode_pub_key(public_key, &pub_key_pt);
+  memcpy(secret_key, &priv_key, SCALAR_BYTES);
+  memcpy(secret_key + SCALAR_BYTES, public_key, RESIDUE_LENGTH_BYTES);
+  explicit_bzero(&priv_key, sizeof(priv_key));
+}
+
+BACKEND_EXPORT void BACKEND_CONCAT(BACKEND, sign)(
+  uint8_t *sig, const uint8_t *secret_key, const uint8_t *msg,
+  size_t msg_len) {
+
+  signature_t sig_struct;
+  scalar_t priv_key;
+  priv_key.limbs[SCALAR_LIMBS - 1] = 0;
+  memcpy(&priv_key, secret_key, SCALAR_BYTES);
+  sign(&sig_struct, &priv_key, secret_key + SCALAR_BYTES, msg, msg_len);
+  encode_sig(sig, &sig_struct);
+  explicit_bzero(&priv_key, sizeof(priv_key));
+}
+
+BACKEND_EXPORT int BACKEND_CONCAT(BACKEND, verify)(
+  const uint8_t *sig, const uint8_t *public_key, const uint8_t *msg,
+  size_t msg_len) {
+
+  signature_t sig_struct;
+  affine_pt_narrow_t pub_key_pt;
+  uint8_t y_buf[RESIDUE_LENGTH_BYTES];
+
+  decode_sig(&sig_struct, sig);
+  if (!decode_pub_key(&pub_key_pt, public_key)) {
+    return 0;
+  }
+  encode(y_buf, &sig_struct.y);
+  return verify(&sig_struct, y_buf, public_key, &pub_key_pt, msg, msg_len);
+}
+
+BACKEND_EXPORT void BACKEND_CONCAT(BACKEND, scalar_mult_base)(
+  uint8_t *result, const uint8_t *scalar) {
+
+  scalar_t n;
+  backend_projective_pt_t result_pt;
+  decode_scalar(&n, scalar);
+  scalar_comb_multiply(&result_pt, &base_comb, &n);
+  point_compress(result, &result_pt);
+  explicit_bzero(&n, sizeof(n));
+}
+
+BACKEND_EXPORT int BACKEND_CONCAT(BACKEND, scalar_mult)(
+  uint8_t *result, const uint8_t *scalar, const uint8_t *point) {
+
+  scalar_t n;
+  affine_pt_narrow_t pt;
+  backend_projective_pt_t result_pt;
+  if (!decode_pub_key(&pt, point)) {
+    return 0;
+  }
+  decode_scalar(&n, scalar);
+  scalar_multiply(&result_pt, &pt, &n);
+  point_compress(result, &result_pt);
+  explicit_bzero(&n, sizeof(n));
+  return 1;
+}
@@ -0,0 +1,47 @@
+// The entry points that each backend exports to the dispatcher. backend.c is
+// compiled once per backend, with BACKEND set to the backend's name, so the
+// entry points are p11_260_ref_sign, p11_260_avx2_sign and so on. All other
+// symbols in a backend object are made local when it is built.
+
+#ifndef BACKEND_H
+#define BACKEND_H
+#include <stddef.h>
+#include <stdint.h>
+
+#define BACKEND_CONCAT2(backend, name) p11_260_##backend##_##name
+#define BACKEND_CONCAT(backend, name) BACKEND_CONCAT2(backend, name)
+
+#define BACKEND_DECLARE(backend) \
+  void BACKEND_CONCAT(backend, gen_key)( \
+    uint8_t *secret_key, uint8_t *public_key); \
+  void BACKEND_CONCAT(backend, sign)( \
+    uint8_t *sig, const uint8_t *secret_key, const uint8_t *msg, \
+    size_t msg_len); \
+  int BACKEND_CONCAT(backend, verify)( \
+    const uint8_t *sig, const uint8_t *public_key, const uint8_t *msg, \
+    size_t msg_len); \
+  void BACKEND_CONCAT(backend, scalar_mult_base)( \
+    uint8_t *result, const uint8_t *scalar); \
+  int BACKEND_CONCAT(backend, scalar_mult)( \
+    uint8_t *result, const uint8_t *scalar, const uint8_t *point);
+
+BACKEND_DECLARE(ref)
+BACKEND_DECLARE(avx2)
+BACKEND_DECLARE(avx512)
+
+typedef struct p11_260_backend {
+  const char *name;
+  // Returns true if the CPU and OS support the backend's instruction set.
+  int (*supported)(void);
+  void (*gen_key)(uint8_t *secret_key, uint8_t *public_key);
+  void (*sign)(
+    uint8_t *sig, const uint8_t *secret_key, const uint8_t *msg,
+    size_t msg_len);
+  int (*verify)(
+    const uint8_t *sig, const uint8_t *public_key, const uint8_t *msg,
+    size_t msg_len);
+  void (*scalar_mult_base)(uint8_t *result, const uint8_t *scalar);
+  int (*scalar_mult)(
+    uint8_t *result, const uint8_t *scalar, const uint8_t *point);
+} p11_260_backend_t;
+#endif
@@ -0,0 +1,76 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "p11_260.h"
+
+static const char *BACKEND_NAMES[] = { "ref", "avx2", "avx512" };
+#define NBACKEND_NAMES (sizeof(BACKEND_NAMES) / sizeof(BACKEND_NAMES[0]))
+
+int main(void) {
+  const char *selected = p11_260_backend();
+  const char *supported[NBACKEND_NAMES];
+  size_t nsupported = 0;
+  for (size_t i = 0; i < NBACKEND_NAMES; ++i) {
+    if (p11_260_use_backend(BACKEND_NAMES[i])) {
+      supported[nsupported++] = BACKEND_NAMES[i];
+    }
+  }
+  assert(nsupported > 0 && strcmp(supported[0], "ref") == 0);
+  assert(!p11_260_use_backend("no such backend"));
+  printf("selected %s, supported:", selected);
+  for (size_t i = 0; i < nsupported; ++i) {
+    printf(" %s", supported[i]);
+  }
+  printf("\n");
+
+  const uint8_t msg[] = "The quick brown fox jumps over the lazy dog";
+  uint8_t scalar[P11_260_SCALAR_BYTES] = {0};
+  uint8_t one[P11_260_SCALAR_BYTES] = {1};
+  for (int i = 0; i < P11_260_SCALAR_BYTES; ++i) {
+    scalar[i] = 37 * i + 11;
+  }
+
+  // Every backend must produce the same points, and accept each other's
+  // signatures.
+  uint8_t expected_base[P11_260_POINT_BYTES];
+  uint8_t expected_sB[P11_260_POINT_BYTES];
+  for (size_t i = 0; i < nsupported; ++i) {
+    uint8_t secret_key[P11_260_SECRET_KEY_BYTES];
+    uint8_t public_key[P11_260_PUBLIC_KEY_BYTES];
+    uint8_t sig[P11_260_SIGNATURE_BYTES];
+    uint8_t base[P11_260_POINT_BYTES];
+    uint8_t sB[P11_260_POINT_BYTES];
+    uint8_t sB_var[P11_260_POINT_BYTES];
+
+    assert(p11_260_use_backend(supported[i]));
+    assert(strcmp(p11_260_backend(), supported[i]) == 0);
+
+    p11_260_scalar_mult_base(base, one);
+    p11_260_scalar_mult_base(sB, scalar);
+    assert(p11_260_scalar_mult(sB_var, scalar, base));
+    assert(memcmp(sB, sB_var, sizeof(sB)) == 0);
+    if (i == 0) {
+      memcpy(expected_base, base, sizeof(base));
+      memcpy(expected_sB, sB, sizeof(sB));
+    } else {
+      assert(memcmp(base, expected_base, sizeof(base)) == 0);
+      assert(memcmp(sB, expected_sB, sizeof(sB)) == 0);
+    }
+
+    p11_260_gen_key(secret_key, public_key);
+    p11_260_sign(sig, secret_key, msg, sizeof(msg));
+    for (size_t j = 0; j < nsupported; ++j) {
+      assert(p11_260_use_backend(supported[j]));
+      assert(p11_260_verify(sig, public_key, msg, sizeof(msg)));
+      assert(!p11_260_verify(sig, public_key, msg, sizeof(msg) - 1));
+      sig[P11_260_SIGNATURE_BYTES - 1] ^= 1;
+      assert(!p11_260_verify(sig, public_key, msg, sizeof(msg)));
+      sig[P11_260_SIGNATURE_BYTES - 1] ^= 1;
+    }
+  }
+
+  assert(p11_260_use_backend(selected));
+  printf("All tests passed\n");
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "backend.h"
+#include "p11_260.h"
+
+static int ref_supported(void) {
+  return 1;
+}
+
+// The avx2 backend is built with -march=haswell.
+static int avx2_supported(void) {
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+    __builtin_cpu_supports("fma");
+}
+
+// The avx512 backend is built with -march=skylake-avx512.
+static int avx512_supported(void) {
+  return avx2_supported() && __builtin_cpu_supports("avx512f") &&
+    __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") &&
+    __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+}
+
+#define BACKEND_ENTRY(backend) { \
+    .name = #backend, \
+    .supported = backend##_supported, \
+    .gen_key = BACKEND_CONCAT(backend, gen_key), \
+    .sign = BACKEND_CONCAT(backend, sign), \
+    .verify = BACKEND_CONCAT(backend, verify), \
+    .scalar_mult_base = BACKEND_CONCAT(backend, scalar_mult_base), \
+    .scalar_mult = BACKEND_CONCAT(backend, scalar_mult), \
+  }
+
+// Fastest first.
+static const p11_260_backend_t backends[] = {
+  BACKEND_ENTRY(avx512),
+  BACKEND_ENTRY(avx2),
+  BACKEND_ENTRY(ref),
+};
+
+#define NBACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+// ref until the constructor runs, so that calls from other constructors are
+// still safe.
+static const p11_260_backend_t *current = &backends[NBACKENDS - 1];
+
+__attribute__((__constructor__))
+static void select_backend(void) {
+  __builtin_cpu_init();
+  const char *name = getenv("P11_260_BACKEND");
+  if (name != NULL && p11_260_use_backend(name)) {
+    return;
+  }
+  for (size_t i = 0; i < NBACKENDS; ++i) {
+    if (backends[i].supported()) {
+      current = &backends[i];
+      return;
+    }
+  }
+}
+
+int p11_260_use_backend(const char *name) {
+  __builtin_cpu_init();
+  for (size_t i = 0; i < NBACKENDS; ++i) {
+    if (strcmp(backends[i].name, name) == 0) {
+      if (!backends[i].supported()) {
+        return 0;
+      }
+      current = &backends[i];
+      return 1;
+    }
+  }
+  return 0;
+}
+
+const char *p11_260_backend(void) {
+  return current->name;
+}
+
+void p11_260_gen_key(uint8_t *secret_key, uint8_t *public_key) {
+  current->gen_key(secret_key, public_key);
+}
+
+void p11_260_sign(
+  uint8_t *sig, const uint8_t *secret_key, const uint8_t *msg,
+  size_t msg_len) {
+  current->sign(sig, secret_key, msg, msg_len);
+}
+
+int p11_260_verify(
+  const uint8_t *sig, const uint8_t *public_key, const uint8_t *msg,
+  size_t msg_len) {
+  return current->verify(sig, public_key, msg, msg_len);
+}
+
+void p11_260_scalar_mult_base(uint8_t *result, const uint8_t *scalar) {
+  current->scalar_mult_base(result, scalar);
+}
+
+int p11_260_scalar_mult(
+  uint8_t *result, const uint8_t *scalar, const uint8_t *point) {
+  return current->scalar_mult(result, scalar, point);
+}
@@ -0,0 +1,82 @@
+// Carry resolution on bit masks, for narrow_complete. Shared by all three
+// backends. Bit i of each mask stands for limb i of an 11 limb residue. Once
+// every limb is in [0, t], no limb receives more than one carry, so which limbs
+// receive one can be found with integer arithmetic on the masks instead of a
+// serial pass over the limbs. The backends compute the masks with vector
+// compares and apply the carries with masked adds.
+
+#ifndef CARRY_MASK_H
+#define CARRY_MASK_H
+#include <stdint.h>
+
+// Limbs 0-10, and the limbs of a reduced residue.
+#define DIGITS_MASK 0x7ff
+#define REDUCED_DIGITS_MASK 0x3ff
+
+// Added to every limb after a reduce step, so that they are all non-negative.
+// Adding the same value to all 11 limbs adds a multiple of p. A reduce step
+// leaves any 32 bit input in (-2^9, t + 2^9).
+#define COMPLETE_OFFSET (1 << 9)
+
+// Limbs that receive a carry, given the limbs that carry out whether or not
+// they receive one (generate) and the limbs that carry out only if they do
+// (propagate). Adding the shifted generate mask to the propagate mask ripples
+// each carry through the run of propagating limbs above it, the way an adder
+// would. Bit 10 of the result is the carry out of limb 9.
+static inline uint32_t carry_in_mask(uint32_t generate, uint32_t propagate) {
+  return (((generate << 1) + propagate) ^ propagate) & DIGITS_MASK;
+}
+
+// Same as carry_in_mask, but the carry out of limb 10 goes into limb 0, as
+// t^11 == 1. The end around carry can't ripple past a generating limb, so one
+// extra add suffices.
+static inline uint32_t carry_in_mask_cyclic(
+  uint32_t generate, uint32_t propagate) {
+  uint32_t sum = (((generate << 1) | (generate >> 10)) & DIGITS_MASK) +
+    propagate;
+  sum = (sum & DIGITS_MASK) + (sum >> 11);
+  return (sum ^ propagate) & DIGITS_MASK;
+}
+
+// Limbs whose carry out is the carry in to the next limb, cyclically.
+static inline uint32_t carry_out_mask_cyclic(uint32_t carry_in) {
+  return ((carry_in >> 1) | (carry_in << 10)) & DIGITS_MASK;
+}
+
+// Masks for the last step of narrow_complete. The input is h, the base t digits
+// of a value in (0, 2p), with h[10] either 0 or 1. p is 11 ones in base t, so
+// h >= p exactly when the run of ones from limb 10 down is ended by a digit
+// above 1, or not ended at all. If so, p is subtracted: every limb in
+// minus_one loses 1, every limb in borrow_in loses another, and every limb in
+// borrow_out gains t. Otherwise h < p is already the result, but a value of at
+// least t^10 is written with its top digits equal to t: the run of ones and
+// the 0 that ends it become digits equal to t from that 0 up to limb 9. Those
+// limbs are in top_t.
+typedef struct complete_masks {
+  uint32_t top_t;
+  uint32_t minus_one;
+  uint32_t borrow_in;
+  uint32_t borrow_out;
+} complete_masks_t;
+
+static inline void complete_masks(
+  complete_masks_t *result, uint32_t ones, uint32_t zeros) {
+
+  // Smear the highest non-one digit downwards. above is the run of ones
+  // from limb 10, and highest is the digit that ends it, if any.
+  uint32_t below = ~ones & DIGITS_MASK;
+  below |= below >> 1;
+  below |= below >> 2;
+  below |= below >> 4;
+  below |= below >> 8;
+  uint32_t above = ~below & DIGITS_MASK;
+  uint32_t highest = below ^ (below >> 1);
+  uint32_t at_least_p = -(uint32_t) (((highest & ~zeros) != 0) | (highest == 0));
+
+  uint32_t borrow = carry_in_mask(zeros, ones);
+  result->top_t = (above | highest) & REDUCED_DIGITS_MASK & ~at_least_p;
+  result->minus_one = REDUCED_DIGITS_MASK & at_least_p;
+  result->borrow_in = borrow & REDUCED_DIGITS_MASK & at_least_p;
+  result->borrow_out = (borrow >> 1) & at_least_p;
+}
+#endif
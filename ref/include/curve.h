@@ -1,5 +1,6 @@
 #ifndef CURVE_H
 #define CURVE_H
+#include <stddef.h>
 #include "f11_260.h"
 #include "scalar.h"
 
@@ -40,9 +41,40 @@ typedef struct extended_pt_narrow {
 
 #define D (-49142)
 
+// Window width for the wNAF of scalars multiplying a variable point, in
+// scalar_multiply_unsafe and double_scalar_multiply_unsafe, and the number of
+// odd multiples of the point that are computed per call. Can be 5 to 7. Wider
+// windows need fewer additions in the main loop, but the table is rebuilt on
+// every call. Counting both, 5 needs the fewest additions for one scalar.
+#ifndef VAR_WNAF_BITS
+#define VAR_WNAF_BITS 5
+#endif
+#if VAR_WNAF_BITS < 5 || VAR_WNAF_BITS > 7
+#error "VAR_WNAF_BITS must be between 5 and 7"
+#endif
+#define VAR_WNAF_TABLE_SIZE (1 << (VAR_WNAF_BITS - 2))
+
+// Window width for the wNAF of the base point scalar in
+// double_scalar_multiply_unsafe, and the number of precomputed odd multiples
+// of the base point that it needs. After changing the width, run
+// make base_wnaf to regenerate include/base_wnaf.c
+#define BASE_WNAF_BITS 7
+#define BASE_WNAF_TABLE_SIZE (1 << (BASE_WNAF_BITS - 2))
+
 __attribute__((__aligned__(32)))
 const affine_pt_narrow_t B;
 
+__attribute__((__aligned__(32)))
+const extended_affine_pt_readd_narrow_t
+base_odd_multiples[BASE_WNAF_TABLE_SIZE];
+
+// Computes the odd multiples x, 3x, ..., in the layout of base_odd_multiples.
+// Shares a single inversion across the table. tools/gen_base_wnaf.c uses this
+// to generate base_odd_multiples.
+void compute_odd_multiples(
+  extended_affine_pt_readd_narrow_t result[BASE_WNAF_TABLE_SIZE],
+  const affine_pt_narrow_t * __restrict x);
+
 void copy_projective_pt_narrow(
   projective_pt_narrow_t *result, const projective_pt_narrow_t *source);
 
@@ -79,6 +111,10 @@ void affine_to_readd_narrow(
   extended_pt_readd_narrow_t *result,
   const affine_pt_narrow_t * __restrict x);
 
+void affine_to_affine_readd_narrow(
+  extended_affine_pt_readd_narrow_t *result,
+  const affine_pt_narrow_t * __restrict x);
+
 void extended_to_readd_narrow_neg(
   extended_pt_readd_narrow_t *result,
   const extended_pt_narrow_t * __restrict x);
@@ -163,10 +199,30 @@ void scalar_multiply(
   projective_pt_narrow_t *result, const affine_pt_narrow_t * __restrict x,
   const scalar_t * __restrict n);
 
+// Non-constant time version of scalar_multiply. Walks the width VAR_WNAF_BITS
+// NAF of n, so it only adds for the non-zero digits.
 void scalar_multiply_unsafe(
   projective_pt_narrow_t *result, const affine_pt_narrow_t * __restrict x,
   const scalar_t * __restrict n);
 
+// Non-constant time computation of s * B + h * x. Walks the wNAF forms of both
+// scalars with one shared chain of doublings, using the precomputed odd
+// multiples of B and a small table of odd multiples of x. Can be safely used
+// during signature verification because there are no secrets during
+// verification.
+void double_scalar_multiply_unsafe(
+  projective_pt_narrow_t *result, const scalar_t * __restrict s,
+  const affine_pt_narrow_t * __restrict x, const scalar_t * __restrict h);
+
+// Non-constant time computation of the sum of scalars[i] * points[i], using
+// Pippenger's bucket method. The window width is chosen from n, so the cost
+// grows sub-linearly in the number of points. Can be safely used during
+// signature verification because there are no secrets during verification.
+// Returns 0 if the working tables could not be allocated.
+int multi_scalar_multiply_unsafe(
+  projective_pt_narrow_t *result, const affine_pt_narrow_t *points,
+  const scalar_t *scalars, size_t n);
+
 int point_decompress(
   affine_pt_narrow_t *result, residue_narrow_reduced_t *y, int low_bit);
 #endif
@@ -0,0 +1,304 @@
+// Inversion by divsteps, from Bernstein and Yang, "Fast constant-time gcd
+// computation and modular inversion". Each divstep replaces (delta, f, g) with
+//   (1 - delta, g, (g - f) / 2)   if delta > 0 and g is odd,
+//   (1 + delta, f, (g + f) / 2)   if g is odd,
+//   (1 + delta, f, g / 2)         otherwise.
+// Starting from f = p and g = x, g reaches 0 and f reaches +-1. Steps are done
+// in batches of 62 on the low 64 bits of f and g, which gives a 2x2 matrix
+// that is then applied to the full numbers. The same matrix, applied mod p to
+// (d, e) = (0, 1), tracks the inverse. The update of d and e follows
+// secp256k1's modinv64: the matrix entries carry a factor of 2^62, which is
+// cancelled by adding a multiple of p that clears the low 62 bits.
+//
+// The numbers are binary, in 5 signed limbs of 62 bits, so the field's base t
+// representation is converted in and out. Both conversions are a handful of
+// multiplies. The input is converted without reducing it first, which costs an
+// extra batch of divsteps but is cheaper than narrow_complete.
+
+#include <stdint.h>
+#include "divsteps.h"
+#include "f11_260.h"
+
+#define DIVSTEPS_BATCH 62
+// The input is less than 2^31 * t^11 / (t - 1) < 2^292 in absolute value. For
+// f = p and g that size, 845 divsteps are enough to reach g = 0. (Theorem 11.2
+// of the paper, with d = 292.) 14 batches is 868.
+#define DIVSTEPS_BATCHES 14
+#define DIVSTEPS_LIMBS 5
+#define M62 (UINT64_MAX >> 2)
+
+// A number as sum(v[i] * 2^(62 * i)). Limbs 0 through 3 are in [0, 2^62). The
+// top limb is signed.
+typedef struct signed62 {
+  int64_t v[DIVSTEPS_LIMBS];
+} signed62_t;
+
+// The matrix of a batch, times 2^62:
+// [u v]
+// [q r]
+// |u| + |v| and |q| + |r| are at most 2^62.
+typedef struct divsteps_trans {
+  int64_t u, v, q, r;
+} divsteps_trans_t;
+
+// p = (t^11 - 1) / (t - 1)
+static const signed62_t modulus_62 = {{
+  0x1a8f59a43ada019b, 0x0f59288420296bf0, 0x149dfd173da3cc11,
+  0x3f6b0009c1bf9f12, 0xfff,
+}};
+// p^-1 mod 2^62
+static const uint64_t modulus_inv_62 = 0x16506eea71be7c93;
+
+// Horner's rule on the limbs: x = x * t + limb. The limbs may be negative, and
+// so may the result.
+static void from_limbs_62(
+  signed62_t *result, const int32_t x[DIVSTEPS_DIGITS]) {
+  int64_t v[DIVSTEPS_LIMBS] = {0};
+  for (int i = DIVSTEPS_DIGITS - 1; i >= 0; --i) {
+    __int128 carry = x[i];
+    for (int k = 0; k < DIVSTEPS_LIMBS - 1; ++k) {
+      carry += (__int128) v[k] * T;
+      v[k] = (uint64_t) carry & M62;
+      carry >>= 62;
+    }
+    v[DIVSTEPS_LIMBS - 1] = carry + (__int128) v[DIVSTEPS_LIMBS - 1] * T;
+  }
+  for (int k = 0; k < DIVSTEPS_LIMBS; ++k) {
+    result->v[k] = v[k];
+  }
+}
+
+// x must be in [0, p). Repeated long division by t, in 32-bit chunks so that
+// each step's dividend fits in 58 bits.
+#define DIVSTEPS_CHUNKS 9
+static void to_digits_62(int32_t result[DIVSTEPS_DIGITS], const signed62_t *x) {
+  uint64_t chunks[DIVSTEPS_CHUNKS];
+  for (int j = 0; j < DIVSTEPS_CHUNKS; ++j) {
+    int k = (32 * j) / 62;
+    int shift = (32 * j) % 62;
+    uint64_t chunk = (uint64_t) x->v[k] >> shift;
+    if (k + 1 < DIVSTEPS_LIMBS) {
+      chunk |= (uint64_t) x->v[k + 1] << (62 - shift);
+    }
+    chunks[j] = chunk & UINT32_MAX;
+  }
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    uint64_t rem = 0;
+    for (int j = DIVSTEPS_CHUNKS - 1; j >= 0; --j) {
+      uint64_t n = (rem << 32) | chunks[j];
+      uint64_t quot = ((unsigned __int128) n * RECIP_T) >> RECIP_T_SHIFT;
+      rem = n - quot * T;
+      chunks[j] = quot;
+    }
+    result[i] = rem;
+  }
+  result[NLIMBS_REDUCED] = chunks[0];
+}
+
+// 62 divsteps on the low bits of f and g. Returns the new delta. Constant time.
+static int64_t divsteps_62(
+  int64_t delta, uint64_t f, uint64_t g, divsteps_trans_t *t) {
+  uint64_t u = 1, v = 0, q = 0, r = 1;
+  for (int i = 0; i < DIVSTEPS_BATCH; ++i) {
+    uint64_t odd = -(g & 1);
+    uint64_t swap = (uint64_t) (-delta >> 63) & odd;
+    uint64_t x;
+    // Replace (delta, f, g) with (-delta, g, -f) if swapping.
+    x = (f ^ g) & swap;
+    f ^= x;
+    g ^= x;
+    g = (g ^ swap) - swap;
+    x = (u ^ q) & swap;
+    u ^= x;
+    q ^= x;
+    q = (q ^ swap) - swap;
+    x = (v ^ r) & swap;
+    v ^= x;
+    r ^= x;
+    r = (r ^ swap) - swap;
+    delta = (delta ^ (int64_t) swap) - (int64_t) swap;
+    // Add f to g if g was odd. g is now even.
+    g += f & odd;
+    q += u & odd;
+    r += v & odd;
+    g >>= 1;
+    u <<= 1;
+    v <<= 1;
+    ++delta;
+  }
+  t->u = u;
+  t->v = v;
+  t->q = q;
+  t->r = r;
+  return delta;
+}
+
+// Same as divsteps_62, but in variable time. Runs of zero bits in g are taken
+// all at once.
+static int64_t divsteps_62_var(
+  int64_t delta, uint64_t f, uint64_t g, divsteps_trans_t *t) {
+  uint64_t u = 1, v = 0, q = 0, r = 1;
+  uint64_t x;
+  int i = DIVSTEPS_BATCH;
+  for (;;) {
+    // The bits above i stop the count at the end of the batch.
+    int zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+    g >>= zeros;
+    u <<= zeros;
+    v <<= zeros;
+    delta += zeros;
+    i -= zeros;
+    if (i == 0) {
+      break;
+    }
+    if (delta > 0) {
+      delta = -delta;
+      x = f; f = g; g = -x;
+      x = u; u = q; q = -x;
+      x = v; v = r; r = -x;
+    }
+    g += f;
+    q += u;
+    r += v;
+    g >>= 1;
+    u <<= 1;
+    v <<= 1;
+    ++delta;
+    --i;
+  }
+  t->u = u;
+  t->v = v;
+  t->q = q;
+  t->r = r;
+  return delta;
+}
+
+// (f, g) = t * (f, g) / 2^62. The division is exact.
+static void update_fg_62(
+  signed62_t *f, signed62_t *g, const divsteps_trans_t *t) {
+  const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+  __int128 cf = (__int128) u * f->v[0] + (__int128) v * g->v[0];
+  __int128 cg = (__int128) q * f->v[0] + (__int128) r * g->v[0];
+  cf >>= 62;
+  cg >>= 62;
+  for (int i = 1; i < DIVSTEPS_LIMBS; ++i) {
+    cf += (__int128) u * f->v[i] + (__int128) v * g->v[i];
+    cg += (__int128) q * f->v[i] + (__int128) r * g->v[i];
+    f->v[i - 1] = (uint64_t) cf & M62;
+    g->v[i - 1] = (uint64_t) cg & M62;
+    cf >>= 62;
+    cg >>= 62;
+  }
+  f->v[DIVSTEPS_LIMBS - 1] = cf;
+  g->v[DIVSTEPS_LIMBS - 1] = cg;
+}
+
+// (d, e) = t * (d, e) / 2^62 mod p. d and e must be in (-2p, p), and stay
+// there.
+static void update_de_62(
+  signed62_t *d, signed62_t *e, const divsteps_trans_t *t) {
+  const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+  // Start with (u, q) if d is negative, plus (v, r) if e is negative. This
+  // keeps the result in range.
+  int64_t sd = d->v[DIVSTEPS_LIMBS - 1] >> 63;
+  int64_t se = e->v[DIVSTEPS_LIMBS - 1] >> 63;
+  int64_t md = (u & sd) + (v & se);
+  int64_t me = (q & sd) + (r & se);
+  __int128 cd = (__int128) u * d->v[0] + (__int128) v * e->v[0];
+  __int128 ce = (__int128) q * d->v[0] + (__int128) r * e->v[0];
+  // Choose md and me so that the low 62 bits of t * (d, e) + p * (md, me)
+  // are zero.
+  md -= (modulus_inv_62 * (uint64_t) cd + md) & M62;
+  me -= (modulus_inv_62 * (uint64_t) ce + me) & M62;
+  cd += (__int128) modulus_62.v[0] * md;
+  ce += (__int128) modulus_62.v[0] * me;
+  cd >>= 62;
+  ce >>= 62;
+  for (int i = 1; i < DIVSTEPS_LIMBS; ++i) {
+    cd += (__int128) u * d->v[i] + (__int128) v * e->v[i];
+    ce += (__int128) q * d->v[i] + (__int128) r * e->v[i];
+    cd += (__int128) modulus_62.v[i] * md;
+    ce += (__int128) modulus_62.v[i] * me;
+    d->v[i - 1] = (uint64_t) cd & M62;
+    e->v[i - 1] = (uint64_t) ce & M62;
+    cd >>= 62;
+    ce >>= 62;
+  }
+  d->v[DIVSTEPS_LIMBS - 1] = cd;
+  e->v[DIVSTEPS_LIMBS - 1] = ce;
+}
+
+// Bring limbs 0 through 3 back to [0, 2^62).
+static void carry_62(signed62_t *x) {
+  for (int i = 0; i < DIVSTEPS_LIMBS - 1; ++i) {
+    x->v[i + 1] += x->v[i] >> 62;
+    x->v[i] &= M62;
+  }
+}
+
+// Add p to x if x is negative.
+static void cond_add_modulus_62(signed62_t *x) {
+  int64_t mask = x->v[DIVSTEPS_LIMBS - 1] >> 63;
+  for (int i = 0; i < DIVSTEPS_LIMBS; ++i) {
+    x->v[i] += modulus_62.v[i] & mask;
+  }
+  carry_62(x);
+}
+
+// Bring x in (-2p, p) to [0, p), negating it first if sign is negative.
+static void normalize_62(signed62_t *x, int64_t sign) {
+  cond_add_modulus_62(x);
+  int64_t negate = sign >> 63;
+  for (int i = 0; i < DIVSTEPS_LIMBS; ++i) {
+    x->v[i] = (x->v[i] ^ negate) - negate;
+  }
+  carry_62(x);
+  cond_add_modulus_62(x);
+}
+
+static int is_zero_62(const signed62_t *x) {
+  int64_t acc = 0;
+  for (int i = 0; i < DIVSTEPS_LIMBS; ++i) {
+    acc |= x->v[i];
+  }
+  return acc == 0;
+}
+
+void invert_divsteps(
+  int32_t result[DIVSTEPS_DIGITS], const int32_t x[DIVSTEPS_DIGITS]) {
+  signed62_t d = {{0}};
+  signed62_t e = {{1}};
+  signed62_t f = modulus_62;
+  signed62_t g;
+  divsteps_trans_t t;
+  int64_t delta = 1;
+
+  from_limbs_62(&g, x);
+  for (int i = 0; i < DIVSTEPS_BATCHES; ++i) {
+    delta = divsteps_62(delta, f.v[0], g.v[0], &t);
+    update_de_62(&d, &e, &t);
+    update_fg_62(&f, &g, &t);
+  }
+  // f is now +-1, and d is 1/x times f.
+  normalize_62(&d, f.v[DIVSTEPS_LIMBS - 1]);
+  to_digits_62(result, &d);
+}
+
+void invert_divsteps_var(
+  int32_t result[DIVSTEPS_DIGITS], const int32_t x[DIVSTEPS_DIGITS]) {
+  signed62_t d = {{0}};
+  signed62_t e = {{1}};
+  signed62_t f = modulus_62;
+  signed62_t g;
+  divsteps_trans_t t;
+  int64_t delta = 1;
+
+  from_limbs_62(&g, x);
+  for (int i = 0; i < DIVSTEPS_BATCHES && !is_zero_62(&g); ++i) {
+    delta = divsteps_62_var(delta, f.v[0], g.v[0], &t);
+    update_de_62(&d, &e, &t);
+    update_fg_62(&f, &g, &t);
+  }
+  normalize_62(&d, f.v[DIVSTEPS_LIMBS - 1]);
+  to_digits_62(result, &d);
+}
@@ -0,0 +1,27 @@
+// Field inversion by Bernstein-Yang divsteps ("safegcd"). Shared by all three
+// backends: the input and output are the 11 limbs in order, which each backend
+// copies from and into its own limb layout.
+
+#ifndef DIVSTEPS_H
+#define DIVSTEPS_H
+#include <stdint.h>
+#include "f11_260.h"
+
+// Number of limbs in the input and result of invert_divsteps.
+#define DIVSTEPS_DIGITS (NLIMBS_REDUCED + 1)
+
+// floor(n * RECIP_T / 2^84) = floor(n / t) for all n < 2^58. Converting to base
+// t divides by t, and this avoids the variable time divide instruction.
+#define RECIP_T 0x400000f00003841ULL
+#define RECIP_T_SHIFT 84
+
+// Sets result to the base t digits of 1/x, each in [0, t). The value is less
+// than p, so the last digit is 0 or 1. x is sum(x[i] * t^i), and needs no
+// reduction. x must not be 0 mod p. Constant time.
+void invert_divsteps(
+  int32_t result[DIVSTEPS_DIGITS], const int32_t x[DIVSTEPS_DIGITS]);
+
+// Same as invert_divsteps, but in variable time. Only for public values.
+void invert_divsteps_var(
+  int32_t result[DIVSTEPS_DIGITS], const int32_t x[DIVSTEPS_DIGITS]);
+#endif
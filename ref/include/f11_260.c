@@ -1,11 +1,32 @@
 #include <stdint.h>
 #include "f11_260.h"
+#include "carry_mask.h"
+#include "divsteps.h"
+
+// Shared by all the backends. See divsteps.h
+#include "divsteps.c"
 
 residue_narrow_t zero_narrow = {0};
 residue_narrow_t one_narrow = {
   .limbs = {1},
 };
 
+#ifdef FIELD_BOUNDS_CHECK
+#include <assert.h>
+
+void check_bounds_narrow(const residue_narrow_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
+
+void check_bounds_wide(const residue_wide_t *x) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    assert(x->limbs[i] >= -MUL_LIMB_BOUND && x->limbs[i] <= MUL_LIMB_BOUND);
+  }
+}
+#endif
+
 // Shrink to 32 bits. Assumes reduction has already occurred, and wide storage
 // is being used for vector compatibility.
 void narrow(residue_narrow_t *result, const residue_wide_t * __restrict w) {
@@ -29,50 +50,108 @@ void narrow_reduce(
   }
 }
 
-// Reduce to unique representative.
-// This is expensive. Only used for final signature or DH Key
-void narrow_complete(
-  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+// Sets result to the base t digits of a value congruent to x, in 11 limbs each
+// in [0, t). Any 32 bit limbs are accepted.
+static void complete_digits(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x) {
 
   residue_narrow_t temp;
+  reduce_step_narrow(&temp, x);
+
+  uint32_t carry = 0;
+  #pragma clang loop unroll(full)
   for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[10];
+    temp.limbs[i] += COMPLETE_OFFSET;
+    carry |= (temp.limbs[i] >= T) << i;
   }
+  uint32_t carry_rot = ((carry << 1) | (carry >> 10)) & DIGITS_MASK;
 
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
+  uint32_t generate = 0;
+  uint32_t propagate = 0;
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    temp.limbs[i] -= T & -((carry >> i) & 1);
+    temp.limbs[i] += (carry_rot >> i) & 1;
+    generate |= (temp.limbs[i] == T) << i;
+    propagate |= (temp.limbs[i] == T - 1) << i;
+  }
+  uint32_t carry_in = carry_in_mask_cyclic(generate, propagate);
+  uint32_t carry_out = carry_out_mask_cyclic(carry_in);
 
-  int gt_mask = 0;
-  int lt_mask = 0;
-  int32_t limit[NLIMBS];
+  #pragma clang loop unroll(full)
   for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[10];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
+    result->limbs[i] = temp.limbs[i] + ((carry_in >> i) & 1) -
+      (T & -((carry_out >> i) & 1));
   }
+}
+
+// Given digits from complete_digits, sets result to the digits of h in (0, 2p)
+// as expected by complete_masks. Subtracting digit 10 from the others takes off
+// digit 10 times p. Adding t to the lower 10 digits, and 1 more to digit 0,
+// adds p back, and leaves every digit in [1, 2t].
+static void complete_offset_digits(
+  residue_narrow_t *result, const residue_narrow_t * __restrict e) {
+
+  residue_narrow_t temp;
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    temp.limbs[i] = e->limbs[i] - e->limbs[10] + T;
+  }
+  temp.limbs[0] += 1;
+  temp.limbs[10] = 0;
+
+  uint32_t carry = 0;
+  #pragma clang loop unroll(full)
   for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] -= temp.limbs[10];
-    limit[i] = T;
+    carry |= (temp.limbs[i] >= T) << i;
   }
-  int64_t all_t = -1;
-  for (int i = NLIMBS_REDUCED - 2; i >= 0; --i) {
-    all_t &= -(temp.limbs[i+1] == T);
-    limit[i] -= 1 & (~all_t);
+
+  uint32_t generate = 0;
+  uint32_t propagate = 0;
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    temp.limbs[i] -= T & -((carry >> i) & 1);
+    temp.limbs[i] += ((carry << 1) >> i) & 1;
+    generate |= (temp.limbs[i] == T) << i;
+    propagate |= (temp.limbs[i] == T - 1) << i;
+  }
+  uint32_t carry_in = carry_in_mask(generate, propagate);
+  uint32_t carry_out = carry_in >> 1;
+
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    result->limbs[i] = temp.limbs[i] + ((carry_in >> i) & 1) -
+      (T & -((carry_out >> i) & 1));
+  }
+}
+
+// Reduce to unique representative.
+// Limbs are in [0, t), except that a value of at least t^10 has its top limbs
+// equal to t. Branch free: the carries are resolved with mask arithmetic, see
+// carry_mask.h
+void narrow_complete(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+
+  residue_narrow_t base_t_digits, digits;
+  complete_digits(&base_t_digits, w);
+  complete_offset_digits(&digits, &base_t_digits);
+
+  uint32_t ones = 0;
+  uint32_t zeros = 0;
+  #pragma clang loop unroll(full)
+  for (int i = 0; i < NLIMBS; ++i) {
+    ones |= (digits.limbs[i] == 1) << i;
+    zeros |= (digits.limbs[i] == 0) << i;
   }
-  gt_mask = 0;
-  lt_mask = 0;
+  complete_masks_t masks;
+  complete_masks(&masks, ones, zeros);
+
+  #pragma clang loop unroll(full)
   for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > limit[i]);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i] = temp.limbs[i];
+    int32_t top_t = -((masks.top_t >> i) & 1);
+    int32_t limb = digits.limbs[i] - ((masks.minus_one >> i) & 1) -
+      ((masks.borrow_in >> i) & 1) + (T & -((masks.borrow_out >> i) & 1));
+    result->limbs[i] = (limb & ~top_t) | (T & top_t);
   }
 }
 
@@ -80,43 +159,20 @@ void narrow_complete(
 // All coefficients are reduced to 0 <= xi <= t
 // Unique up to carries (xi == t) => (xi = 0; x[i+1] += 1);
 // This is sufficient to determine if x is even or odd.
-// Still pretty expensive. Used in point compression.
+// The mask based narrow_complete is no more expensive than a partial form
+// would be, so this is the complete form.
 void narrow_partial_complete(
   residue_narrow_reduced_t *result, const residue_narrow_t * __restrict w) {
+  narrow_complete(result, w);
+}
 
-  residue_narrow_t temp;
-  for (int i = 0; i < NLIMBS; ++i) {
-    temp.limbs[i] = w->limbs[i] - w->limbs[10];
-  }
-
-  // This may be combined with the final reduction from a multiply.
-  reduce_step_narrow(&temp, &temp);
-
-  int gt_mask = 0;
-  int lt_mask = 0;
-  for (int i = 0; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] = temp.limbs[i] - temp.limbs[10];
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-  }
-  for (int i = 0; i < NLIMBS - 1; ++i) {
-    temp.limbs[i] -= temp.limbs[10];
-  }
-  gt_mask = 0;
-  lt_mask = 0;
-  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
-    temp.limbs[i] += 1 & gt_mask;
-    temp.limbs[i] -= 1 & lt_mask;
-    gt_mask = -(temp.limbs[i] > T);
-    lt_mask = -(temp.limbs[i] < 0);
-    temp.limbs[i] -= (T & gt_mask);
-    temp.limbs[i] += (T & lt_mask);
-    result->limbs[i] = temp.limbs[i];
-  }
+void narrow_compress(
+  residue_narrow_reduced_t *result, const residue_narrow_t * __restrict x,
+  const residue_narrow_t * __restrict y) {
+  residue_narrow_reduced_t x_reduced;
+  narrow_complete(&x_reduced, x);
+  narrow_complete(result, y);
+  result->limbs[NLIMBS_REDUCED - 1] |= is_odd(&x_reduced) << TBITS;
 }
 
 int is_odd(residue_narrow_reduced_t *x) {
@@ -198,6 +254,8 @@ void double_wide(
 // to 32 bits, but not narrowed for performance reasons.
 void mul_wide(
   residue_wide_t *result, const residue_wide_t *x, const residue_wide_t *y) {
+  CHECK_BOUNDS_WIDE(x);
+  CHECK_BOUNDS_WIDE(y);
 
   residue_wide_t temp;
   for (int i = 0; i < NLIMBS; ++i) {
@@ -217,6 +275,8 @@ void mul_wide(
 // reduced to 32 bits, but not narrowed for performance reasons.
 void mul_wide_narrow(
   residue_wide_t *result, const residue_wide_t *x, const residue_narrow_t *y) {
+  CHECK_BOUNDS_WIDE(x);
+  CHECK_BOUNDS_NARROW(y);
 
   residue_wide_t temp;
   for (int i = 0; i < NLIMBS; ++i) {
@@ -236,6 +296,8 @@ void mul_wide_narrow(
 void mul_narrow(
   residue_narrow_t *result, const residue_narrow_t *x,
   const residue_narrow_t *y) {
+  CHECK_BOUNDS_NARROW(x);
+  CHECK_BOUNDS_NARROW(y);
 
   residue_wide_t temp;
   for (int i = 0; i < NLIMBS; ++i) {
@@ -270,6 +332,7 @@ void mul_narrow_const(
 // 32 bits but not narrowed for performance reasons.
 void square_narrow(
   residue_narrow_t *result, const residue_narrow_t *x) {
+  CHECK_BOUNDS_NARROW(x);
 
   residue_wide_t temp;
   for (int i = 0; i < NLIMBS; ++i) {
@@ -483,7 +546,7 @@ int sqrt_inv_narrow(
   return equal_narrow(&should_be_x, x);
 }
 
-void invert_narrow(
+void invert_narrow_fermat(
   residue_narrow_t *result, const residue_narrow_t * __restrict x) {
 
   residue_narrow_t x_t_minus_1_over_4;
@@ -500,6 +563,40 @@ void invert_narrow(
   mul_narrow(result, &phi_8_x_t_t, &x_t_minus_1);
 }
 
+void invert_narrow(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x) {
+  invert_divsteps(result->limbs, x->limbs);
+}
+
+void invert_narrow_var(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x) {
+  invert_divsteps_var(result->limbs, x->limbs);
+}
+
+void invert_narrow_batch(
+  residue_narrow_t *out, const residue_narrow_t *in, size_t n) {
+  residue_narrow_t acc_inv;
+
+  if (n == 0) {
+    return;
+  }
+
+  // out[i] = in[0] * ... * in[i]
+  copy_narrow(&out[0], &in[0]);
+  for (size_t i = 1; i < n; ++i) {
+    mul_narrow(&out[i], &out[i - 1], &in[i]);
+  }
+
+  // acc_inv is the inverse of in[0] * ... * in[i]. Peel off one input per
+  // step.
+  invert_narrow(&acc_inv, &out[n - 1]);
+  for (size_t i = n - 1; i > 0; --i) {
+    mul_narrow(&out[i], &acc_inv, &out[i - 1]);
+    mul_narrow(&acc_inv, &acc_inv, &in[i]);
+  }
+  copy_narrow(&out[0], &acc_inv);
+}
+
 void encode(uint8_t *out, const residue_narrow_reduced_t * __restrict x) {
   uint32_t collect = x->limbs[0];
 
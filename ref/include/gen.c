@@ -35,16 +35,84 @@ void gen_key(scalar_t * __restrict priv_key,
   explicit_bzero(&temp_narrow, sizeof(temp_narrow));
 }
 
+#ifdef BATCH8
+void gen_key_batch8(scalar_t * __restrict priv_keys,
+                    affine_pt_narrow_t * __restrict pub_keys) {
+  scalar_hash_t large_key;
+  for (int i = 0; i < LANES_X8; ++i) {
+    arc4random_buf(&large_key, sizeof(large_key));
+    mont_reduce_hash_mod_l(&priv_keys[i], &large_key);
+  }
+
+  projective_pt_narrow_t result_pts[LANES_X8];
+  scalar_comb_multiply_x8(result_pts, &base_comb, priv_keys);
+
+  residue_narrow_t z[LANES_X8];
+  residue_narrow_t z_inv[LANES_X8];
+  for (int i = 0; i < LANES_X8; ++i) {
+    copy_narrow(&z[i], &result_pts[i].z);
+  }
+  invert_narrow_batch(z_inv, z, LANES_X8);
+
+  for (int i = 0; i < LANES_X8; ++i) {
+    mul_narrow(&pub_keys[i].x, &result_pts[i].x, &z_inv[i]);
+    mul_narrow(&pub_keys[i].y, &result_pts[i].y, &z_inv[i]);
+  }
+
+  explicit_bzero(&large_key, sizeof(large_key));
+  explicit_bzero(result_pts, sizeof(result_pts));
+  explicit_bzero(z_inv, sizeof(z_inv));
+}
+#endif
+
 void encode_pub_key(uint8_t *result, const affine_pt_narrow_t *pub_key) {
   residue_narrow_reduced_t y_reduced;
-  residue_narrow_reduced_t x_reduced;
-  narrow_complete(&y_reduced, &pub_key->y);
-  narrow_partial_complete(&x_reduced, &pub_key->x);
-
-  y_reduced.limbs[NLIMBS_REDUCED - 1] |= is_odd(&x_reduced) << TBITS;
+  narrow_compress(&y_reduced, &pub_key->x, &pub_key->y);
   encode(result, &y_reduced);
 }
 
+void point_compress(uint8_t *result, const projective_pt_narrow_t *pt) {
+  residue_narrow_t z_inv;
+  affine_pt_narrow_t affine_pt;
+
+  invert_narrow(&z_inv, &pt->z);
+  mul_narrow(&affine_pt.x, &pt->x, &z_inv);
+  mul_narrow(&affine_pt.y, &pt->y, &z_inv);
+  encode_pub_key(result, &affine_pt);
+
+  explicit_bzero(&z_inv, sizeof(z_inv));
+  explicit_bzero(&affine_pt, sizeof(affine_pt));
+}
+
+void point_compress_batch(
+  uint8_t *result, const projective_pt_narrow_t *pts, size_t n) {
+  residue_narrow_t z[POINT_COMPRESS_BATCH];
+  residue_narrow_t z_inv[POINT_COMPRESS_BATCH];
+  affine_pt_narrow_t affine_pt;
+
+  for (size_t start = 0; start < n; start += POINT_COMPRESS_BATCH) {
+    size_t count = n - start;
+    if (count > POINT_COMPRESS_BATCH) {
+      count = POINT_COMPRESS_BATCH;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      copy_narrow(&z[i], &pts[start + i].z);
+    }
+    invert_narrow_batch(z_inv, z, count);
+
+    for (size_t i = 0; i < count; ++i) {
+      mul_narrow(&affine_pt.x, &pts[start + i].x, &z_inv[i]);
+      mul_narrow(&affine_pt.y, &pts[start + i].y, &z_inv[i]);
+      encode_pub_key(
+        result + (start + i) * RESIDUE_LENGTH_BYTES, &affine_pt);
+    }
+  }
+
+  explicit_bzero(z, sizeof(z));
+  explicit_bzero(z_inv, sizeof(z_inv));
+  explicit_bzero(&affine_pt, sizeof(affine_pt));
+}
+
 int decode_pub_key(affine_pt_narrow_t *result, const uint8_t *encoded_key) {
   residue_narrow_reduced_t y_decoded;
   decode(&y_decoded, encoded_key);
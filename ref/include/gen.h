@@ -3,9 +3,32 @@
 
 #include "scalar.h"
 #include "curve.h"
+#ifdef BATCH8
+#include "comb_x8.h"
+#endif
 
 void gen_key(scalar_t * __restrict priv_key,
              affine_pt_narrow_t * __restrict pub_key);
+#ifdef BATCH8
+// Generates LANES_X8 key pairs, sharing the comb multiplication and inversion
+// like sign_batch8.
+void gen_key_batch8(scalar_t * __restrict priv_keys,
+                    affine_pt_narrow_t * __restrict pub_keys);
+#endif
 void encode_pub_key(uint8_t *result, const affine_pt_narrow_t *pub_key);
 int decode_pub_key(affine_pt_narrow_t *result, const uint8_t *encoded_key);
+
+// Encodes a projective point the same way as encode_pub_key, into
+// RESIDUE_LENGTH_BYTES bytes. Constant time.
+void point_compress(uint8_t *result, const projective_pt_narrow_t *pt);
+
+// Points compressed per inversion by point_compress_batch. Bounds the scratch
+// space on the stack.
+#define POINT_COMPRESS_BATCH 32
+
+// Encodes n projective points into n * RESIDUE_LENGTH_BYTES bytes at result.
+// Each run of POINT_COMPRESS_BATCH points shares one inversion. Constant time
+// in everything but n.
+void point_compress_batch(
+  uint8_t *result, const projective_pt_narrow_t *pts, size_t n);
 #endif
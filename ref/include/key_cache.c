@@ -0,0 +1,137 @@
+#include <blake2.h>
+#include <stdlib.h>
+#include <string.h>
+#include "comb.h"
+#include "curve.h"
+#include "gen.h"
+#include "key_cache.h"
+
+static uint64_t key_cache_hash(
+  const key_cache_t *cache, const uint8_t *pub_key_bytes) {
+  uint64_t result;
+  blake2b_state hash_ctxt;
+  blake2b_init_key(&hash_ctxt, sizeof(result), cache->hash_key,
+                   sizeof(cache->hash_key));
+  blake2b_update(&hash_ctxt, pub_key_bytes, RESIDUE_LENGTH_BYTES);
+  blake2b_final(&hash_ctxt, (uint8_t *) &result, sizeof(result));
+  return result;
+}
+
+// Smallest power of 2 that is at least x.
+static uint64_t key_cache_round_up(uint64_t x) {
+  uint64_t result = 1;
+  while (result < x) {
+    result <<= 1;
+  }
+  return result;
+}
+
+int key_cache_init(key_cache_t *cache, size_t capacity, int admit_hits) {
+  uint64_t bucket_count = key_cache_round_up(capacity);
+  uint64_t hits_count = key_cache_round_up(4 * capacity);
+
+  cache->entries = aligned_alloc(
+    _Alignof(key_cache_entry_t), capacity * sizeof(key_cache_entry_t));
+  cache->buckets = malloc(bucket_count * sizeof(int32_t));
+  cache->hits = calloc(hits_count, 1);
+  if (capacity == 0 || cache->entries == NULL || cache->buckets == NULL ||
+      cache->hits == NULL) {
+    key_cache_destroy(cache);
+    return 0;
+  }
+
+  for (uint64_t i = 0; i < bucket_count; ++i) {
+    cache->buckets[i] = -1;
+  }
+  cache->capacity = capacity;
+  cache->size = 0;
+  cache->hand = 0;
+  cache->bucket_mask = bucket_count - 1;
+  cache->hits_mask = hits_count - 1;
+  if (admit_hits < 1) {
+    admit_hits = 1;
+  } else if (admit_hits > KEY_CACHE_MAX_ADMIT_HITS) {
+    admit_hits = KEY_CACHE_MAX_ADMIT_HITS;
+  }
+  cache->admit_hits = admit_hits;
+  arc4random_buf(cache->hash_key, sizeof(cache->hash_key));
+  return 1;
+}
+
+void key_cache_destroy(key_cache_t *cache) {
+  free(cache->entries);
+  free(cache->buckets);
+  free(cache->hits);
+  cache->entries = NULL;
+  cache->buckets = NULL;
+  cache->hits = NULL;
+  cache->capacity = 0;
+  cache->size = 0;
+}
+
+static void key_cache_unlink(key_cache_t *cache, int32_t index) {
+  int32_t *link = &cache->buckets[cache->entries[index].hash &
+                                  cache->bucket_mask];
+  while (*link != index) {
+    link = &cache->entries[*link].next;
+  }
+  *link = cache->entries[index].next;
+}
+
+// Picks a slot for a new entry, evicting one if the cache is full.
+static int32_t key_cache_claim(key_cache_t *cache) {
+  if (cache->size < cache->capacity) {
+    return cache->size++;
+  }
+
+  while (cache->entries[cache->hand].referenced) {
+    cache->entries[cache->hand].referenced = 0;
+    cache->hand = (cache->hand + 1) % cache->capacity;
+  }
+  int32_t victim = cache->hand;
+  cache->hand = (cache->hand + 1) % cache->capacity;
+  key_cache_unlink(cache, victim);
+  return victim;
+}
+
+const key_cache_entry_t *key_cache_lookup(
+  key_cache_t *cache, const uint8_t *pub_key_bytes) {
+
+  uint64_t hash = key_cache_hash(cache, pub_key_bytes);
+  for (int32_t i = cache->buckets[hash & cache->bucket_mask]; i != -1;
+       i = cache->entries[i].next) {
+    key_cache_entry_t *entry = &cache->entries[i];
+    if (entry->hash == hash &&
+        memcmp(entry->pub_key_bytes, pub_key_bytes,
+               RESIDUE_LENGTH_BYTES) == 0) {
+      entry->referenced = 1;
+      return entry;
+    }
+  }
+
+  uint8_t *hits = &cache->hits[hash & cache->hits_mask];
+  if (*hits < KEY_CACHE_MAX_ADMIT_HITS) {
+    ++(*hits);
+  }
+  if (*hits < cache->admit_hits) {
+    return NULL;
+  }
+
+  affine_pt_narrow_t pub_key_pt;
+  if (!decode_pub_key(&pub_key_pt, pub_key_bytes)) {
+    return NULL;
+  }
+  *hits = 0;
+
+  int32_t index = key_cache_claim(cache);
+  key_cache_entry_t *entry = &cache->entries[index];
+  compute_comb_set(&entry->comb, &pub_key_pt);
+  copy_narrow(&entry->pub_key_pt.x, &pub_key_pt.x);
+  copy_narrow(&entry->pub_key_pt.y, &pub_key_pt.y);
+  memcpy(entry->pub_key_bytes, pub_key_bytes, RESIDUE_LENGTH_BYTES);
+  entry->hash = hash;
+  entry->referenced = 0;
+  entry->next = cache->buckets[hash & cache->bucket_mask];
+  cache->buckets[hash & cache->bucket_mask] = index;
+  return entry;
+}
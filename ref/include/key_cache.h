@@ -0,0 +1,63 @@
+#ifndef KEY_CACHE_H
+#define KEY_CACHE_H
+#include <stddef.h>
+#include <stdint.h>
+#include "comb.h"
+#include "curve.h"
+#include "f11_260.h"
+
+// Default number of lookups of a key before it is admitted to the cache.
+// Computing a comb costs several verifications, so one-off keys shouldn't
+// evict keys that are actually reused.
+#define KEY_CACHE_DEFAULT_ADMIT_HITS 2
+// The lookup counts are bytes, so admit_hits can be at most this.
+#define KEY_CACHE_MAX_ADMIT_HITS UINT8_MAX
+
+// A cached public key: the decoded point and its comb set.
+typedef struct key_cache_entry {
+  sabs_comb_set_t comb;
+  affine_pt_narrow_t pub_key_pt;
+  uint8_t pub_key_bytes[RESIDUE_LENGTH_BYTES];
+  uint64_t hash;
+  // Next entry in the same hash chain, or -1.
+  int32_t next;
+  // Set on every hit, cleared as the eviction clock passes.
+  uint8_t referenced;
+} key_cache_entry_t;
+
+// A bounded cache of comb sets keyed by the encoded public key. Keys are
+// admitted after they have been looked up admit_hits times, and evicted
+// using the clock (second chance) policy once the cache is full. Not thread
+// safe.
+typedef struct key_cache {
+  key_cache_entry_t *entries;
+  // Heads of the hash chains, indexed by hash & bucket_mask.
+  int32_t *buckets;
+  // Lookup counts for keys that aren't cached yet, indexed by
+  // hash & hits_mask. Colliding keys share a counter, which can only admit a
+  // key early.
+  uint8_t *hits;
+  size_t capacity;
+  size_t size;
+  size_t hand;
+  uint64_t bucket_mask;
+  uint64_t hits_mask;
+  int admit_hits;
+  // Random key for the hash, so that chains can't be lengthened on purpose.
+  uint8_t hash_key[16];
+} key_cache_t;
+
+// Allocates a cache that holds up to capacity keys. admit_hits is clamped to
+// [1, KEY_CACHE_MAX_ADMIT_HITS]. Returns 0 on allocation failure.
+int key_cache_init(key_cache_t *cache, size_t capacity, int admit_hits);
+
+void key_cache_destroy(key_cache_t *cache);
+
+// Looks up an encoded public key. Returns the cached entry if there is one.
+// Otherwise counts the lookup, and once the key has been seen admit_hits times
+// decodes it, computes its comb and returns the new entry. Returns NULL if the
+// key isn't (yet) cached or doesn't decode. The entry stays valid until the
+// next call to key_cache_lookup.
+const key_cache_entry_t *key_cache_lookup(
+  key_cache_t *cache, const uint8_t *pub_key_bytes);
+#endif
@@ -0,0 +1,137 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nonce_pool.h"
+#include "sign.h"
+
+static void *nonce_pool_fill(void *arg) {
+  nonce_pool_t *pool = arg;
+  presignature_t presig;
+
+  pthread_mutex_lock(&pool->lock);
+  while (!pool->stop) {
+    if (pool->count == pool->capacity) {
+      pthread_cond_wait(&pool->not_full, &pool->lock);
+      continue;
+    }
+    // ctx doesn't change while the thread runs, so it can be read unlocked.
+    pthread_mutex_unlock(&pool->lock);
+    presign(&presig, &pool->ctx);
+    pthread_mutex_lock(&pool->lock);
+
+    // Only this thread adds entries, so there is still room.
+    if (!pool->stop) {
+      size_t tail = (pool->head + pool->count) % pool->capacity;
+      memcpy(&pool->entries[tail], &presig, sizeof(presig));
+      ++pool->count;
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  explicit_bzero(&presig, sizeof(presig));
+  return NULL;
+}
+
+// Called at the start of each operation on the pool. After a fork, the child
+// has the parent's entries, which the parent will also hand out, and no worker
+// thread. The child wipes the entries and starts its own worker. The parent's
+// worker may have held the lock when the process forked, so the lock and the
+// condition are made afresh rather than taken.
+static void nonce_pool_check_fork(nonce_pool_t *pool) {
+  pid_t pid = getpid();
+  if (pool->pid == pid) {
+    return;
+  }
+
+  pool->pid = pid;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->not_full, NULL);
+  explicit_bzero(pool->entries, pool->capacity * sizeof(presignature_t));
+  pool->head = 0;
+  pool->count = 0;
+  pool->stop = 0;
+  // Without a worker, nonce_pool_take computes every presignature itself.
+  pool->has_worker =
+    pthread_create(&pool->worker, NULL, nonce_pool_fill, pool) == 0;
+}
+
+int nonce_pool_init(
+  nonce_pool_t *pool, const signing_ctx_t *ctx, size_t capacity) {
+  if (capacity == 0) {
+    return 0;
+  }
+  pool->entries = aligned_alloc(
+    _Alignof(presignature_t), capacity * sizeof(presignature_t));
+  if (pool->entries == NULL) {
+    return 0;
+  }
+
+  pool->capacity = capacity;
+  pool->head = 0;
+  pool->count = 0;
+  pool->stop = 0;
+  pool->pid = getpid();
+  memcpy(&pool->ctx, ctx, sizeof(signing_ctx_t));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->not_full, NULL);
+  if (pthread_create(&pool->worker, NULL, nonce_pool_fill, pool) != 0) {
+    pthread_cond_destroy(&pool->not_full);
+    pthread_mutex_destroy(&pool->lock);
+    signing_ctx_destroy(&pool->ctx);
+    free(pool->entries);
+    pool->entries = NULL;
+    return 0;
+  }
+  pool->has_worker = 1;
+  return 1;
+}
+
+void nonce_pool_destroy(nonce_pool_t *pool) {
+  nonce_pool_check_fork(pool);
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = 1;
+  pthread_cond_signal(&pool->not_full);
+  pthread_mutex_unlock(&pool->lock);
+  if (pool->has_worker) {
+    pthread_join(pool->worker, NULL);
+  }
+
+  pthread_cond_destroy(&pool->not_full);
+  pthread_mutex_destroy(&pool->lock);
+  explicit_bzero(pool->entries, pool->capacity * sizeof(presignature_t));
+  signing_ctx_destroy(&pool->ctx);
+  free(pool->entries);
+  pool->entries = NULL;
+  pool->capacity = 0;
+  pool->count = 0;
+}
+
+void nonce_pool_take(nonce_pool_t *pool, presignature_t *result) {
+  nonce_pool_check_fork(pool);
+  pthread_mutex_lock(&pool->lock);
+  if (pool->count == 0) {
+    pthread_mutex_unlock(&pool->lock);
+    presign(result, &pool->ctx);
+    return;
+  }
+
+  presignature_t *entry = &pool->entries[pool->head];
+  memcpy(result, entry, sizeof(presignature_t));
+  explicit_bzero(entry, sizeof(presignature_t));
+  pool->head = (pool->head + 1) % pool->capacity;
+  --pool->count;
+  pthread_cond_signal(&pool->not_full);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+void sign_pooled(
+  signature_t *result, nonce_pool_t *pool, const uint8_t *msg,
+  size_t msg_len) {
+  presignature_t presig;
+
+  nonce_pool_take(pool, &presig);
+  sign_presigned(result, &presig, &pool->ctx, msg, msg_len);
+
+  explicit_bzero(&presig, sizeof(presig));
+}
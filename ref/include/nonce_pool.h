@@ -0,0 +1,56 @@
+#ifndef NONCE_POOL_H
+#define NONCE_POOL_H
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "scalar.h"
+#include "sign.h"
+
+// A bounded pool of presignatures for one key pair, kept full by a
+// background thread. Signing from the pool leaves only the challenge hash and
+// a few scalar operations on the request path. Each presignature is handed out
+// once, and zeroized in the pool as it is taken. Thread safe.
+//
+// A child process inherits a copy of the parent's presignatures, and signing
+// two messages with one session key reveals the private key. So the pool
+// records the process that filled it. In a child, the first call to
+// nonce_pool_take, sign_pooled or nonce_pool_destroy wipes the inherited
+// entries and starts a new thread. That first call must come before the child
+// shares the pool between threads.
+typedef struct nonce_pool {
+  presignature_t *entries;
+  size_t capacity;
+  // entries[head], ..., entries[head + count - 1], mod capacity, are ready.
+  size_t head;
+  size_t count;
+  signing_ctx_t ctx;
+  pthread_mutex_t lock;
+  // Signalled when an entry is taken, or the pool is being destroyed.
+  pthread_cond_t not_full;
+  pthread_t worker;
+  int stop;
+  // The process the entries belong to.
+  pid_t pid;
+  // Whether worker was started in this process.
+  int has_worker;
+} nonce_pool_t;
+
+// Copies ctx, allocates room for capacity presignatures and starts the thread
+// that fills it. Returns 0 if allocation or starting the thread fails.
+int nonce_pool_init(
+  nonce_pool_t *pool, const signing_ctx_t *ctx, size_t capacity);
+
+// Stops the thread, and zeroizes and frees the pool.
+void nonce_pool_destroy(nonce_pool_t *pool);
+
+// Takes a presignature from the pool. If the pool is empty, computes one
+// instead of waiting for the thread.
+void nonce_pool_take(nonce_pool_t *pool, presignature_t *result);
+
+// Same as sign_ctx with the pool's key pair, but uses a presignature from the
+// pool.
+void sign_pooled(
+  signature_t *result, nonce_pool_t *pool, const uint8_t *msg,
+  size_t msg_len);
+#endif
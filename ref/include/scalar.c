@@ -112,6 +112,46 @@ void convert_to_sabs(
   divide_by_2_mod_l(result, result);
 }
 
+uint32_t scalar_window(const scalar_t *x, int pos, int bits) {
+  int limb = pos / SCALAR_LIMB_BITS;
+  if (limb >= SCALAR_LIMBS) {
+    return 0;
+  }
+  uint64_t window = x->limbs[limb];
+  if (limb + 1 < SCALAR_LIMBS) {
+    window |= ((uint64_t) x->limbs[limb + 1]) << SCALAR_LIMB_BITS;
+  }
+  return (window >> (pos % SCALAR_LIMB_BITS)) & ((1 << bits) - 1);
+}
+
+int convert_to_wnaf(int8_t *result, const scalar_t *x, int width) {
+  const int WNAF_LENGTH = SCALAR_WNAF_LENGTH;
+  int length = 0;
+  int carry = 0;
+  memset(result, 0, WNAF_LENGTH);
+
+  int bit = 0;
+  while (bit < WNAF_LENGTH) {
+    if ((int) scalar_window(x, bit, 1) == carry) {
+      ++bit;
+      continue;
+    }
+
+    int now = width;
+    if (now > WNAF_LENGTH - bit) {
+      now = WNAF_LENGTH - bit;
+    }
+    int32_t digit = scalar_window(x, bit, now) + carry;
+    carry = (digit >> (width - 1)) & 1;
+    digit -= carry << width;
+    result[bit] = digit;
+    length = bit + 1;
+    bit += now;
+  }
+
+  return length;
+}
+
 void mont_reduce_hash_mod_l(
   scalar_t *result, const scalar_hash_t * __restrict x) {
   uint32_t accum[HASH_LIMBS];
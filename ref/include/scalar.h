@@ -19,6 +19,9 @@ typedef struct scalar_hash {
 #define SCALAR_LIMB_BITS 32
 #define SCALAR_LAST_LIMB_BITS 2
 #define SCALAR_LAST_LIMB_MASK 0x3
+// The montgomery reductions only reduce below 2l, so scalars can have one more
+// bit than l. A wNAF of such a scalar can carry one digit past that.
+#define SCALAR_WNAF_LENGTH (SCALAR_BITS + 2)
 
 // Constants
 // A scalar representing l, the order of the prime subgroup.
@@ -67,4 +70,14 @@ void mont_reduce_hash_mod_l(
 void reduce_hash_mod_l(scalar_t *result, const scalar_hash_t * __restrict x);
 
 void convert_to_sabs(scalar_t *result, const scalar_t * __restrict x);
+
+// Returns bits [pos, pos + bits) of x. bits must be at most 32.
+uint32_t scalar_window(const scalar_t *x, int pos, int bits);
+
+// Recode x in width-w non-adjacent form: every nonzero digit is odd, less than
+// 2^(w-1) in absolute value, and followed by at least w-1 zero digits. x must
+// be less than 2^(SCALAR_BITS + 1), and result must have room for
+// SCALAR_WNAF_LENGTH digits. Returns the index of the highest nonzero digit
+// plus one. Not constant time.
+int convert_to_wnaf(int8_t *result, const scalar_t *x, int width);
 #endif
@@ -5,6 +5,8 @@
 
 #include "comb.h"
 #include "curve.h"
+#include "key_cache.h"
+#include "nonce_pool.h"
 #include "scalar.h"
 
 #include "sign.h"
@@ -15,15 +17,23 @@
 #include "gen.c"
 #include "constant_time.c"
 #include "comb.c"
+#include "key_cache.c"
+#include "nonce_pool.c"
+#ifdef BATCH8
+#include "f11_260_x8.c"
+#include "comb_x8.c"
+#endif
 
-void sign(signature_t *result, scalar_t *priv_key,
-  const uint8_t *pub_key, const uint8_t *msg, size_t msg_len) {
+// Derives the session key for a signature of msg. The hash is keyed with fresh
+// randomness, so that a weak random source alone doesn't reveal the key.
+static void sign_session_key(
+  scalar_t *session_key, const scalar_t *priv_key, const uint8_t *msg,
+  size_t msg_len) {
   blake2b_state hash_ctxt;
 
   char session_key_wash[16];
 
   scalar_hash_t scalar_large;
-  scalar_t session_key;
 
   arc4random_buf(session_key_wash, sizeof(session_key_wash));
   blake2b_init_key(&hash_ctxt, 64, session_key_wash, sizeof(session_key_wash));
@@ -31,41 +41,272 @@ void sign(signature_t *result, scalar_t *priv_key,
   blake2b_update(&hash_ctxt, (uint8_t *) msg, msg_len);
   blake2b_final(&hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
 
-  reduce_hash_mod_l(&session_key, &scalar_large);
+  reduce_hash_mod_l(session_key, &scalar_large);
 
-  projective_pt_narrow_t result_pt;
-  scalar_comb_multiply(&result_pt, &base_comb, &session_key);
-  residue_narrow_t z_inv;
+  explicit_bzero(&scalar_large, sizeof(scalar_large));
+  explicit_bzero(&session_key_wash, sizeof(session_key_wash));
+}
+
+// Key for the challenge hash of prehashed signatures. Keyed BLAKE2b is a
+// different function from the unkeyed hash of other signatures, so a signature
+// of a digest in prehash mode isn't also a signature of the digest itself.
+static const char PREHASH_DOMAIN[] = "p11_260 prehash";
+
+// Starts the challenge hash H(R || A || M), up to the message.
+static void challenge_init(
+  blake2b_state *hash_ctxt, const uint8_t *r_bytes,
+  const uint8_t *pub_key_bytes, int prehashed) {
+  if (prehashed) {
+    blake2b_init_key(
+      hash_ctxt, 64, PREHASH_DOMAIN, sizeof(PREHASH_DOMAIN) - 1);
+  } else {
+    blake2b_init(hash_ctxt, 64);
+  }
+  blake2b_update(hash_ctxt, r_bytes, RESIDUE_LENGTH_BYTES);
+  blake2b_update(hash_ctxt, pub_key_bytes, RESIDUE_LENGTH_BYTES);
+}
 
-  invert_narrow(&z_inv, &result_pt.z);
-  mul_narrow(&result_pt.x, &result_pt.x, &z_inv);
-  mul_narrow(&result_pt.y, &result_pt.y, &z_inv);
+// Converts a private key to the form sign_finish takes. See signing_ctx_t.
+static void sign_key_mont(scalar_t *result, const scalar_t *priv_key) {
+  mont_mult_mod_l(result, priv_key, &SCALAR_MONT_R2_HASH_MUL);
+}
 
-  narrow_complete(&result->y, &result_pt.y);
+// Completes a signature given the session key, and R = session_key * B as
+// compressed by point_compress. priv_key_mont is from sign_key_mont. If
+// prehashed, msg is the digest of the message.
+static void sign_finish(
+  signature_t *result, const scalar_t *session_key, const uint8_t *r_bytes,
+  const scalar_t *priv_key_mont, const uint8_t *pub_key, const uint8_t *msg,
+  size_t msg_len, int prehashed) {
+  blake2b_state hash_ctxt;
 
-  residue_narrow_reduced_t temp_narrow_reduced;
-  narrow_partial_complete(&temp_narrow_reduced, &result_pt.x);
-  result->y.limbs[NLIMBS_REDUCED - 1] |=
-      is_odd(&temp_narrow_reduced) << (TBITS);
+  scalar_hash_t scalar_large;
 
-  uint8_t y_buf[RESIDUE_LENGTH_BYTES];
-  encode(y_buf, &result->y);
+  decode(&result->y, r_bytes);
 
-  blake2b_init(&hash_ctxt, 64);
-  blake2b_update(&hash_ctxt, y_buf, RESIDUE_LENGTH_BYTES);
-  blake2b_update(&hash_ctxt, pub_key, RESIDUE_LENGTH_BYTES);
+  challenge_init(&hash_ctxt, r_bytes, pub_key, prehashed);
   blake2b_update(&hash_ctxt, msg, msg_len);
   blake2b_final(&hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
 
   scalar_t hash_scalar;
   mont_reduce_hash_mod_l(&hash_scalar, &scalar_large);
-  mont_mult_mod_l(&hash_scalar, &hash_scalar, priv_key);
-  mont_mult_mod_l(&hash_scalar, &hash_scalar, &SCALAR_MONT_R2_HASH_MUL);
-  sub_mod_l(&result->s, &session_key, &hash_scalar);
+  mont_mult_mod_l(&hash_scalar, &hash_scalar, priv_key_mont);
+  sub_mod_l(&result->s, session_key, &hash_scalar);
 
-  explicit_bzero(&session_key, sizeof(session_key));
   explicit_bzero(&hash_scalar, sizeof(hash_scalar));
-  explicit_bzero(&session_key_wash, sizeof(session_key_wash));
+}
+
+static void sign_with_key(
+  signature_t *result, const scalar_t *priv_key,
+  const scalar_t *priv_key_mont, const uint8_t *pub_key, const uint8_t *msg,
+  size_t msg_len, int prehashed) {
+
+  scalar_t session_key;
+  sign_session_key(&session_key, priv_key, msg, msg_len);
+
+  projective_pt_narrow_t result_pt;
+  scalar_comb_multiply(&result_pt, &base_comb, &session_key);
+  uint8_t r_bytes[RESIDUE_LENGTH_BYTES];
+  point_compress(r_bytes, &result_pt);
+
+  sign_finish(
+    result, &session_key, r_bytes, priv_key_mont, pub_key, msg, msg_len,
+    prehashed);
+
+  explicit_bzero(&session_key, sizeof(session_key));
+  explicit_bzero(&result_pt, sizeof(result_pt));
+}
+
+void sign(signature_t *result, scalar_t *priv_key,
+  const uint8_t *pub_key, const uint8_t *msg, size_t msg_len) {
+  scalar_t priv_key_mont;
+  sign_key_mont(&priv_key_mont, priv_key);
+  sign_with_key(result, priv_key, &priv_key_mont, pub_key, msg, msg_len, 0);
+  explicit_bzero(&priv_key_mont, sizeof(priv_key_mont));
+}
+
+int signing_ctx_init(signing_ctx_t *ctx, const uint8_t *secret_key) {
+  ctx->priv_key.limbs[SCALAR_LIMBS - 1] = 0;
+  memcpy(&ctx->priv_key, secret_key, SCALAR_BYTES);
+  sign_key_mont(&ctx->priv_key_mont, &ctx->priv_key);
+  memcpy(ctx->pub_key, secret_key + SCALAR_BYTES, RESIDUE_LENGTH_BYTES);
+  if (!decode_pub_key(&ctx->pub_key_pt, ctx->pub_key)) {
+    signing_ctx_destroy(ctx);
+    return 0;
+  }
+  return 1;
+}
+
+void signing_ctx_destroy(signing_ctx_t *ctx) {
+  explicit_bzero(ctx, sizeof(signing_ctx_t));
+}
+
+void sign_ctx(
+  signature_t *result, const signing_ctx_t *ctx, const uint8_t *msg,
+  size_t msg_len) {
+  sign_with_key(
+    result, &ctx->priv_key, &ctx->priv_key_mont, ctx->pub_key, msg, msg_len,
+    0);
+}
+
+int verify_ctx(
+  const signing_ctx_t *ctx, const signature_t *sig, const uint8_t *msg,
+  size_t msg_len) {
+  uint8_t r_bytes[RESIDUE_LENGTH_BYTES];
+  encode(r_bytes, &sig->y);
+  return verify(sig, r_bytes, ctx->pub_key, &ctx->pub_key_pt, msg, msg_len);
+}
+
+void presign(presignature_t *result, const signing_ctx_t *ctx) {
+  sign_session_key(&result->session_key, &ctx->priv_key, NULL, 0);
+
+  projective_pt_narrow_t result_pt;
+  scalar_comb_multiply(&result_pt, &base_comb, &result->session_key);
+  point_compress(result->r_bytes, &result_pt);
+
+  explicit_bzero(&result_pt, sizeof(result_pt));
+}
+
+void sign_presigned(
+  signature_t *result, const presignature_t *presig, const signing_ctx_t *ctx,
+  const uint8_t *msg, size_t msg_len) {
+  sign_finish(
+    result, &presig->session_key, presig->r_bytes, &ctx->priv_key_mont,
+    ctx->pub_key, msg, msg_len, 0);
+}
+
+void sign_prehash_init(sign_prehash_t *state) {
+  blake2b_init(&state->hash_ctxt, PREHASH_BYTES);
+}
+
+void sign_prehash_update(
+  sign_prehash_t *state, const uint8_t *chunk, size_t len) {
+  blake2b_update(&state->hash_ctxt, chunk, len);
+}
+
+void sign_prehash_digest(uint8_t *digest, sign_prehash_t *state) {
+  blake2b_final(&state->hash_ctxt, digest, PREHASH_BYTES);
+  explicit_bzero(state, sizeof(sign_prehash_t));
+}
+
+void sign_prehash_final(
+  signature_t *result, sign_prehash_t *state, const signing_ctx_t *ctx) {
+  uint8_t digest[PREHASH_BYTES];
+  sign_prehash_digest(digest, state);
+  sign_prehashed(result, ctx, digest);
+}
+
+void sign_prehashed(
+  signature_t *result, const signing_ctx_t *ctx, const uint8_t *digest) {
+  sign_with_key(
+    result, &ctx->priv_key, &ctx->priv_key_mont, ctx->pub_key, digest,
+    PREHASH_BYTES, 1);
+}
+
+#ifdef BATCH8
+void sign_batch8(signature_t *result, scalar_t *priv_key,
+  const uint8_t *pub_key, const uint8_t * const *msgs,
+  const size_t *msg_lens) {
+
+  scalar_t session_keys[LANES_X8];
+  for (int i = 0; i < LANES_X8; ++i) {
+    sign_session_key(&session_keys[i], priv_key, msgs[i], msg_lens[i]);
+  }
+
+  projective_pt_narrow_t result_pts[LANES_X8];
+  scalar_comb_multiply_x8(result_pts, &base_comb, session_keys);
+
+  uint8_t r_bytes[LANES_X8][RESIDUE_LENGTH_BYTES];
+  point_compress_batch(&r_bytes[0][0], result_pts, LANES_X8);
+
+  scalar_t priv_key_mont;
+  sign_key_mont(&priv_key_mont, priv_key);
+  for (int i = 0; i < LANES_X8; ++i) {
+    sign_finish(
+      &result[i], &session_keys[i], r_bytes[i], &priv_key_mont, pub_key,
+      msgs[i], msg_lens[i], 0);
+  }
+
+  explicit_bzero(session_keys, sizeof(session_keys));
+  explicit_bzero(result_pts, sizeof(result_pts));
+  explicit_bzero(&priv_key_mont, sizeof(priv_key_mont));
+}
+#endif
+
+// Returns the parity of the canonical form of x.
+static int narrow_is_odd(const residue_narrow_t *x) {
+  residue_narrow_reduced_t temp;
+  narrow_partial_complete(&temp, x);
+  return is_odd(&temp);
+}
+
+// Checks that result_pt, the computed value of R, matches the compressed R in
+// the signature. The check is cofactored, like verify_batch: result_pt may
+// differ from R by one of the points of order dividing 4, (0, 1), (0, -1),
+// (1, 0) and (-1, 0). For R = (x, y) those sums are (x, y), (-x, -y), (y, -x)
+// and (-y, x), so either coordinate may be compared with +-y projectively, and
+// signatures that match none are rejected without an inversion. The other
+// coordinate is then +-x, whose parity is in the signature.
+static int verify_result_pt(
+  const signature_t *sig, const projective_pt_narrow_t *result_pt) {
+  residue_narrow_reduced_t sig_y;
+  residue_narrow_reduced_t sig_y_canonical;
+  residue_narrow_t sig_y_narrow;
+  residue_narrow_t neg_sig_y;
+  residue_narrow_t y_check;
+  residue_narrow_t neg_y_check;
+
+  copy_narrow_reduced(&sig_y, &sig->y);
+  int sig_x_is_odd = sig_y.limbs[NLIMBS_REDUCED - 1] >> TBITS;
+  sig_y.limbs[NLIMBS_REDUCED - 1] &= TMASK;
+  unnarrow_reduce(&sig_y_narrow, &sig_y);
+
+  // Only the canonical encoding of y is accepted.
+  narrow_complete(&sig_y_canonical, &sig_y_narrow);
+  if (!equal_narrow_reduced(&sig_y_canonical, &sig_y)) {
+    return 0;
+  }
+
+  mul_narrow(&y_check, &sig_y_narrow, &result_pt->z);
+  negate_narrow(&neg_y_check, &y_check);
+  if (!equal_narrow(&y_check, &result_pt->y) &&
+      !equal_narrow(&neg_y_check, &result_pt->y) &&
+      !equal_narrow(&y_check, &result_pt->x) &&
+      !equal_narrow(&neg_y_check, &result_pt->x)) {
+    return 0;
+  }
+
+  residue_narrow_t z_inv;
+  residue_narrow_t x, y, neg_x, neg_y;
+  invert_narrow_var(&z_inv, &result_pt->z);
+  mul_narrow(&x, &result_pt->x, &z_inv);
+  mul_narrow(&y, &result_pt->y, &z_inv);
+  negate_narrow(&neg_x, &x);
+  negate_narrow(&neg_y, &y);
+  negate_narrow(&neg_sig_y, &sig_y_narrow);
+
+  return (equal_narrow(&y, &sig_y_narrow) &&
+          narrow_is_odd(&x) == sig_x_is_odd) ||
+    (equal_narrow(&y, &neg_sig_y) && narrow_is_odd(&neg_x) == sig_x_is_odd) ||
+    (equal_narrow(&x, &sig_y_narrow) &&
+     narrow_is_odd(&neg_y) == sig_x_is_odd) ||
+    (equal_narrow(&x, &neg_sig_y) && narrow_is_odd(&y) == sig_x_is_odd);
+}
+
+// Checks sig against the challenge hash h = H(R || A || M).
+static int verify_challenge(
+  const signature_t *sig, const affine_pt_narrow_t *pub_key_pt,
+  const scalar_hash_t *challenge) {
+
+  projective_pt_narrow_t result_pt;
+
+  scalar_t hash_scalar;
+  reduce_hash_mod_l(&hash_scalar, challenge);
+
+  double_scalar_multiply_unsafe(
+    &result_pt, &sig->s, pub_key_pt, &hash_scalar);
+
+  return verify_result_pt(sig, &result_pt);
 }
 
 int verify(
@@ -73,44 +314,211 @@ int verify(
   const affine_pt_narrow_t *pub_key_pt, const uint8_t *msg,
   size_t msg_len) {
 
+  scalar_hash_t scalar_large;
+  blake2b_state hash_ctxt;
+  challenge_init(&hash_ctxt, r_bytes, pub_key_bytes, 0);
+  blake2b_update(&hash_ctxt, msg, msg_len);
+  blake2b_final(&hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
+
+  return verify_challenge(sig, pub_key_pt, &scalar_large);
+}
+
+int verify_prehashed(
+  const signature_t *sig, const uint8_t *r_bytes, const uint8_t *pub_key_bytes,
+  const affine_pt_narrow_t *pub_key_pt, const uint8_t *digest) {
+
+  scalar_hash_t scalar_large;
+  blake2b_state hash_ctxt;
+  challenge_init(&hash_ctxt, r_bytes, pub_key_bytes, 1);
+  blake2b_update(&hash_ctxt, digest, PREHASH_BYTES);
+  blake2b_final(&hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
+
+  return verify_challenge(sig, pub_key_pt, &scalar_large);
+}
+
+void verify_init(
+  verify_stream_t *state, const signature_t *sig,
+  const uint8_t *pub_key_bytes) {
+  uint8_t r_bytes[RESIDUE_LENGTH_BYTES];
+
+  memcpy(&state->sig, sig, sizeof(signature_t));
+  state->pub_key_valid = decode_pub_key(&state->pub_key_pt, pub_key_bytes);
+  encode(r_bytes, &sig->y);
+  challenge_init(&state->hash_ctxt, r_bytes, pub_key_bytes, 0);
+}
+
+void verify_update(verify_stream_t *state, const uint8_t *chunk, size_t len) {
+  blake2b_update(&state->hash_ctxt, chunk, len);
+}
+
+int verify_final(verify_stream_t *state) {
+  scalar_hash_t scalar_large;
+  blake2b_final(
+    &state->hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
+  if (!state->pub_key_valid) {
+    return 0;
+  }
+  return verify_challenge(&state->sig, &state->pub_key_pt, &scalar_large);
+}
+
+int verify_with_comb(
+  const signature_t *sig, const uint8_t *r_bytes, const uint8_t *pub_key_bytes,
+  const sabs_comb_set_t *pub_key_comb, const uint8_t *msg, size_t msg_len) {
+
   projective_pt_narrow_t sB;
   projective_pt_narrow_t hA;
   projective_pt_narrow_t result_pt;
-  residue_narrow_reduced_t result_y;
 
   scalar_hash_t scalar_large;
   blake2b_state hash_ctxt;
-  blake2b_init(&hash_ctxt, 64);
-  blake2b_update(&hash_ctxt, r_bytes, RESIDUE_LENGTH_BYTES);
-  blake2b_update(&hash_ctxt, pub_key_bytes, RESIDUE_LENGTH_BYTES);
+  challenge_init(&hash_ctxt, r_bytes, pub_key_bytes, 0);
   blake2b_update(&hash_ctxt, msg, msg_len);
   blake2b_final(&hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
 
   scalar_t hash_scalar;
   reduce_hash_mod_l(&hash_scalar, &scalar_large);
 
-  // Can use non-const version for both of these.
   scalar_comb_multiply_unsafe(&sB, &base_comb, &sig->s);
-  scalar_multiply_unsafe(&hA, pub_key_pt, &hash_scalar);
+  scalar_comb_multiply_unsafe(&hA, pub_key_comb, &hash_scalar);
   projective_add(&result_pt, &sB, &hA);
 
-  // Everything below except the comparison should eventually be in helper
-  // functions: Point affinization, and point compression bit-for-bit.
-  // Same applies for the signing.
-  residue_narrow_t z_inv;
+  return verify_result_pt(sig, &result_pt);
+}
+
+int verify_cached(
+  key_cache_t *cache, const signature_t *sig, const uint8_t *r_bytes,
+  const uint8_t *pub_key_bytes, const uint8_t *msg, size_t msg_len) {
+
+  const key_cache_entry_t *entry = key_cache_lookup(cache, pub_key_bytes);
+  if (entry != NULL) {
+    return verify_with_comb(
+      sig, r_bytes, pub_key_bytes, &entry->comb, msg, msg_len);
+  }
+
+  affine_pt_narrow_t pub_key_pt;
+  if (!decode_pub_key(&pub_key_pt, pub_key_bytes)) {
+    return 0;
+  }
+  return verify(sig, r_bytes, pub_key_bytes, &pub_key_pt, msg, msg_len);
+}
+
+// Number of random bytes in each of the batch verification coefficients.
+#define BATCH_Z_BYTES 16
+
+static int scalar_is_reduced(const scalar_t *x) {
+  for (int i = SCALAR_LIMBS - 1; i >= 0; --i) {
+    if (x->limbs[i] != l_bits.limbs[i]) {
+      return x->limbs[i] < l_bits.limbs[i];
+    }
+  }
+  return 0;
+}
+
+int verify_batch(
+  const signature_t *sigs, const uint8_t * const *r_bytes,
+  const uint8_t * const *pub_key_bytes,
+  const affine_pt_narrow_t * const *pub_key_pts,
+  const uint8_t * const *msgs, const size_t *msg_lens, size_t n,
+  int *valid) {
+
+  int batch_valid = 0;
+  affine_pt_narrow_t *points = aligned_alloc(
+    _Alignof(affine_pt_narrow_t), 2 * n * sizeof(affine_pt_narrow_t));
+  scalar_t *scalars = malloc(2 * n * sizeof(scalar_t));
+
+  if (n > 0 && points != NULL && scalars != NULL) {
+    scalar_t s_sum = {0};
+    batch_valid = 1;
+
+    for (size_t i = 0; i < n && batch_valid; ++i) {
+      const signature_t *sig = &sigs[i];
+      scalar_hash_t scalar_large;
+      blake2b_state hash_ctxt;
+      challenge_init(&hash_ctxt, r_bytes[i], pub_key_bytes[i], 0);
+      blake2b_update(&hash_ctxt, msgs[i], msg_lens[i]);
+      blake2b_final(
+        &hash_ctxt, (uint8_t *) &scalar_large, sizeof(scalar_hash_t));
+
+      scalar_t hash_scalar;
+      reduce_hash_mod_l(&hash_scalar, &scalar_large);
+
+      // Recover R from the compressed y coordinate. verify compares against
+      // a canonical y, so reject anything that isn't canonical here.
+      residue_narrow_reduced_t r_y;
+      residue_narrow_reduced_t r_y_canonical;
+      copy_narrow_reduced(&r_y, &sig->y);
+      int r_x_is_odd = r_y.limbs[NLIMBS_REDUCED - 1] >> TBITS;
+      r_y.limbs[NLIMBS_REDUCED - 1] &= TMASK;
+      affine_pt_narrow_t *r_pt = &points[2 * i + 1];
+      if (!scalar_is_reduced(&sig->s) ||
+          !point_decompress(r_pt, &r_y, r_x_is_odd)) {
+        batch_valid = 0;
+        break;
+      }
+      narrow_complete(&r_y_canonical, &r_pt->y);
+      if (!equal_narrow_reduced(&r_y_canonical, &r_y)) {
+        batch_valid = 0;
+        break;
+      }
+      negate_narrow(&r_pt->x, &r_pt->x);
+
+      scalar_t z = {0};
+      scalar_t zs;
+      arc4random_buf(&z, BATCH_Z_BYTES);
+      mult_mod_l(&zs, &z, &sig->s);
+      add_mod_l(&s_sum, &s_sum, &zs);
+
+      copy_narrow(&points[2 * i].x, &pub_key_pts[i]->x);
+      copy_narrow(&points[2 * i].y, &pub_key_pts[i]->y);
+      mult_mod_l(&scalars[2 * i], &z, &hash_scalar);
+      scalars[2 * i + 1] = z;
+    }
+
+    if (batch_valid) {
+      projective_pt_narrow_t sB;
+      projective_pt_narrow_t sum;
+      projective_pt_narrow_t result_pt;
+
+      scalar_comb_multiply_unsafe(&sB, &base_comb, &s_sum);
+      if (multi_scalar_multiply_unsafe(&sum, points, scalars, 2 * n)) {
+        projective_add(&result_pt, &sB, &sum);
+        // Clear the cofactor. verify is cofactored too, so small order
+        // components of the keys or of R are accepted or rejected by both.
+        projective_double(&result_pt, &result_pt);
+        projective_double(&result_pt, &result_pt);
 
-  invert_narrow(&z_inv, &result_pt.z);
-  mul_narrow(&result_pt.x, &result_pt.x, &z_inv);
-  mul_narrow(&result_pt.y, &result_pt.y, &z_inv);
+        batch_valid = equal_narrow(&result_pt.x, &zero_narrow) &&
+          equal_narrow(&result_pt.y, &result_pt.z);
+      } else {
+        batch_valid = 0;
+      }
+    }
+  }
 
-  narrow_complete(&result_y, &result_pt.y);
+  free(points);
+  free(scalars);
 
-  residue_narrow_reduced_t temp_narrow_reduced;
-  narrow_partial_complete(&temp_narrow_reduced, &result_pt.x);
-  result_y.limbs[NLIMBS_REDUCED - 1] |=
-      is_odd(&temp_narrow_reduced) << TBITS;
+  if (batch_valid) {
+    if (valid != NULL) {
+      for (size_t i = 0; i < n; ++i) {
+        valid[i] = 1;
+      }
+    }
+    return 1;
+  }
 
-  return equal_narrow_reduced(&sig->y, &result_y);
+  // Either the allocations failed or at least one signature is bad. Fall back
+  // to checking each signature so the bad ones can be identified.
+  int all_valid = 1;
+  for (size_t i = 0; i < n; ++i) {
+    int sig_valid = verify(&sigs[i], r_bytes[i], pub_key_bytes[i],
+                           pub_key_pts[i], msgs[i], msg_lens[i]);
+    if (valid != NULL) {
+      valid[i] = sig_valid;
+    }
+    all_valid &= sig_valid;
+  }
+  return all_valid;
 }
 
 void encode_sig(uint8_t *result, const signature_t *sig) {
@@ -0,0 +1,103 @@
+// Compares the divsteps inversion in include/divsteps.c, in both its constant
+// time and variable time forms, with the fermat inversion that it replaced,
+// after checking that all three agree. Also times sqrt_inv, which shares the
+// exponentiation chains of the fermat inversion. See the bench_invert target in
+// the Makefile.
+#define _DEFAULT_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "f11_260.h"
+
+#include "f11_260.c"
+
+#define BENCH_INPUTS 16
+#define BENCH_ITERATIONS 2000
+// Report the fastest of several runs, to filter out scheduling noise.
+#define BENCH_RUNS 10
+#define CHECK_ITERATIONS 1000
+
+// Keeps the timed calls from being optimized away.
+static volatile int32_t sink;
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Limbs in [-t/2, t/2], the range of a multiply's output. Zero mod p is
+// unlikely enough to ignore.
+static void random_narrow(residue_narrow_t *result) {
+  for (int i = 0; i < NLIMBS; ++i) {
+    result->limbs[i] = rand() % T - T / 2;
+  }
+}
+
+static void check_agreement(void) {
+  for (int i = 0; i < CHECK_ITERATIONS; ++i) {
+    residue_narrow_t x, expected, actual;
+    random_narrow(&x);
+    invert_narrow_fermat(&expected, &x);
+    invert_narrow(&actual, &x);
+    assert(equal_narrow(&expected, &actual));
+    invert_narrow_var(&actual, &x);
+    assert(equal_narrow(&expected, &actual));
+  }
+}
+
+typedef void (*invert_fn)(
+  residue_narrow_t *result, const residue_narrow_t * __restrict x);
+
+static double time_invert(invert_fn fn, const residue_narrow_t *inputs) {
+  residue_narrow_t result;
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      fn(&result, &inputs[i % BENCH_INPUTS]);
+      sink = result.limbs[1];
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+static double time_sqrt_inv(const residue_narrow_t *inputs) {
+  residue_narrow_t result;
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      sqrt_inv_narrow(&result, &inputs[i % BENCH_INPUTS],
+                      &inputs[(i + 1) % BENCH_INPUTS]);
+      sink = result.limbs[1];
+    }
+    double elapsed = (now_ns() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+int main(void) {
+  residue_narrow_t inputs[BENCH_INPUTS];
+
+  check_agreement();
+
+  for (int i = 0; i < BENCH_INPUTS; ++i) {
+    random_narrow(&inputs[i]);
+  }
+  printf("fermat: %.0f ns\n", time_invert(invert_narrow_fermat, inputs));
+  printf("divsteps: %.0f ns\n", time_invert(invert_narrow, inputs));
+  printf("divsteps, variable time: %.0f ns\n",
+         time_invert(invert_narrow_var, inputs));
+  printf("sqrt_inv: %.0f ns\n", time_sqrt_inv(inputs));
+  return 0;
+}
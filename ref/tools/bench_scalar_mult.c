@@ -0,0 +1,139 @@
+// Compares the wNAF schedule of scalar_multiply_unsafe against the fixed 5-bit
+// signed window schedule that it replaced, and against the constant time
+// scalar_multiply. Build with the same VAR_WNAF_BITS as the library. See the
+// bench_scalar_mult target in the Makefile.
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "comb.h"
+#include "curve.h"
+#include "gen.h"
+#include "scalar.h"
+
+#include "f11_260.c"
+#include "curve.c"
+#include "scalar.c"
+#include "gen.c"
+#include "constant_time.c"
+#include "comb.c"
+#ifdef BATCH8
+#include "f11_260_x8.c"
+#include "comb_x8.c"
+#endif
+
+#define BENCH_POINTS 16
+#define BENCH_ITERATIONS 200
+// Report the fastest of several runs, to filter out scheduling noise.
+#define BENCH_RUNS 10
+
+// The old schedule: add a table entry on every 5-bit window of the SABS form.
+static void scalar_multiply_fixed_unsafe(
+  projective_pt_narrow_t *result, const affine_pt_narrow_t * __restrict x,
+  const scalar_t * __restrict n) {
+
+  scalar_t sabs_n;
+  convert_to_sabs(&sabs_n, n);
+
+  const int WINDOW_BITS = 5;
+  const uint32_t WINDOW_MASK = (1 << WINDOW_BITS) - 1;
+  const uint32_t LOOKUP_MASK = WINDOW_MASK >> 1;
+  const int TABLE_SIZE = 16;
+  extended_pt_readd_narrow_t table[TABLE_SIZE];
+
+  extended_pt_narrow_t x2;
+  affine_double_extended(&x2, x);
+  affine_to_readd_narrow(&table[0], x);
+  for (int i = 1; i < TABLE_SIZE; ++i) {
+    extended_readd_readd_narrow(&table[i], &x2, &table[i-1]);
+  }
+
+  int first = 1;
+  projective_pt_narrow_t temp;
+  extended_pt_narrow_t temp_ext;
+  extended_pt_readd_narrow_t window_pt;
+
+  int i = SCALAR_BITS - ((SCALAR_BITS - 1) % WINDOW_BITS) - 1;
+  for (; i >= 0; i -= WINDOW_BITS) {
+    uint32_t bits = scalar_window(&sabs_n, i, WINDOW_BITS);
+    int32_t invert = (bits >> (WINDOW_BITS - 1)) - 1;
+    bits ^= invert;
+
+    copy_extended_pt_readd_narrow(&window_pt, &table[bits & LOOKUP_MASK]);
+    if (invert) {
+      negate_extended_pt_readd_narrow(&window_pt, &window_pt);
+    }
+
+    if (first) {
+      readd_to_projective(&temp, &window_pt);
+      first = 0;
+    } else {
+      for (int i = 0; i < WINDOW_BITS - 1; ++i) {
+        projective_double(&temp, &temp);
+      }
+      projective_double_extended(&temp_ext, &temp);
+      extended_readd_narrow(&temp, &temp_ext, &window_pt);
+    }
+  }
+
+  copy_projective_pt_narrow(result, &temp);
+}
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+typedef void (*scalar_mult_fn)(
+  projective_pt_narrow_t *result, const affine_pt_narrow_t * __restrict x,
+  const scalar_t * __restrict n);
+
+static double time_scalar_mult(
+  scalar_mult_fn fn, const affine_pt_narrow_t *points,
+  const scalar_t *scalars) {
+  projective_pt_narrow_t result;
+  double best = 0;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    double start = now_us();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+      fn(&result, &points[i % BENCH_POINTS], &scalars[i % BENCH_POINTS]);
+    }
+    double elapsed = (now_us() - start) / BENCH_ITERATIONS;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+int main(void) {
+  affine_pt_narrow_t points[BENCH_POINTS];
+  scalar_t scalars[BENCH_POINTS];
+  affine_pt_narrow_t unused_pt;
+  scalar_t unused_scalar;
+
+  int additions = 0;
+  for (int i = 0; i < BENCH_POINTS; ++i) {
+    int8_t wnaf[SCALAR_WNAF_LENGTH];
+    gen_key(&unused_scalar, &points[i]);
+    gen_key(&scalars[i], &unused_pt);
+    int len = convert_to_wnaf(wnaf, &scalars[i], VAR_WNAF_BITS);
+    for (int j = 0; j < len; ++j) {
+      additions += wnaf[j] != 0;
+    }
+  }
+
+  printf("fixed 5-bit windows: %d additions, %.1f us\n",
+         (SCALAR_BITS + 4) / 5,
+         time_scalar_mult(scalar_multiply_fixed_unsafe, points, scalars));
+  printf("width %d wNAF: %.1f additions on average, %.1f us\n",
+         VAR_WNAF_BITS, (double) additions / BENCH_POINTS,
+         time_scalar_mult(scalar_multiply_unsafe, points, scalars));
+  printf("constant time: %d additions, %.1f us\n",
+         (SCALAR_BITS + 4) / 5,
+         time_scalar_mult(scalar_multiply, points, scalars));
+  return 0;
+}
@@ -0,0 +1,96 @@
+// Generates include/base_comb.c: the comb set for the base point, and the
+// SABS adjustment that matches the comb geometry. Build with the same
+// COMB_TEETH and COMB_COUNT as the library, and with COMB_NO_BASE_TABLE so
+// that the stale table isn't compiled in. See the base_comb target in the
+// Makefile.
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "comb.h"
+#include "curve.h"
+#include "scalar.h"
+
+#include "f11_260.c"
+#include "curve.c"
+#include "scalar.c"
+#include "constant_time.c"
+#include "comb.c"
+
+static void print_residue(const char *name, const residue_narrow_t *x) {
+  residue_narrow_reduced_t reduced;
+  narrow_complete(&reduced, x);
+
+  printf("          .%s = {\n", name);
+  printf("            .limbs = {\n");
+  printf("              ");
+  for (int i = 0; i < NLIMBS_REDUCED; ++i) {
+    printf("%#x,", reduced.limbs[i]);
+    if (i == 5) {
+      printf("\n              ");
+    } else {
+      printf(" ");
+    }
+  }
+  printf("0,\n");
+  printf("            },\n");
+  printf("          },\n");
+}
+
+int main(void) {
+  sabs_comb_set_t comb;
+  compute_comb_set(&comb, &B);
+
+  // The signed bits of a comb cover COMB_TEETH * COMB_COUNT * COMB_SEPARATION
+  // bits, so the adjustment is 2^that - 1 mod l.
+  scalar_t adjustment = {0};
+  scalar_t one = {.limbs = {1}};
+  for (int i = 0; i < COMB_TEETH * COMB_COUNT * COMB_SEPARATION; ++i) {
+    add_mod_l(&adjustment, &adjustment, &adjustment);
+    add_mod_l(&adjustment, &adjustment, &one);
+  }
+
+  printf("// Generated by tools/gen_base_comb.c. Do not edit; run make base_comb.\n");
+  printf("#if COMB_TEETH != %d || COMB_COUNT != %d\n", COMB_TEETH, COMB_COUNT);
+  printf("#error \"base_comb.c doesn't match the comb geometry. "
+         "Run make base_comb.\"\n");
+  printf("#endif\n\n");
+
+  printf("// (2^(COMB_TEETH * COMB_COUNT * COMB_SEPARATION) - 1) mod l. Used to\n");
+  printf("// convert to SABS representation for the comb.\n");
+  printf("__attribute__((__aligned__(32)))\n");
+  printf("const scalar_t comb_signed_bits_set_adjustment = {\n");
+  printf("  .limbs = {");
+  for (int i = 0; i < SCALAR_LIMBS; ++i) {
+    if (i == 4) {
+      printf("\n            ");
+    }
+    printf("0x%08x,", adjustment.limbs[i]);
+    if (i != 3 && i != SCALAR_LIMBS - 1) {
+      printf(" ");
+    }
+  }
+  printf("},\n");
+  printf("};\n\n");
+
+  printf("// Comb set for base point. Used for fast signatures.\n");
+  printf("sabs_comb_set_t base_comb = {\n");
+  printf("  .combs = {\n");
+  for (int i = 0; i < COMB_COUNT; ++i) {
+    printf("    {\n");
+    printf("      .table = {\n");
+    for (int j = 0; j < COMB_TABLE_SIZE; ++j) {
+      printf("        {\n");
+      print_residue("x", &comb.combs[i].table[j].x);
+      print_residue("dt", &comb.combs[i].table[j].dt);
+      print_residue("y", &comb.combs[i].table[j].y);
+      printf("        },\n");
+    }
+    printf("      },\n");
+    printf("    },\n");
+  }
+  printf("  },\n");
+  printf("};\n");
+  return 0;
+}